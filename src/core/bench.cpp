@@ -0,0 +1,226 @@
+#include "decompose.hpp"
+#include "generator.hpp"
+#include "portfolio.hpp"
+#include "tempering.hpp"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Zestaw benchmarków solvera: każda para (instancja, silnik) działa w osobnym procesie,
+// żeby szczyt pamięci (ru_maxrss) dotyczył tylko jej. Instancje i seedy są stałe, więc wyniki
+// można porównywać między commitami. Raportuje: zmienne, iteracje, czas, it/s, czas do
+// planu bez konfliktów (gdy go osiągnięto), koszt końcowy i szczyt RSS. Przebieg, którego koszt
+// nie zgadza się z verify_and_report() (0 <=> plan poprawny), kończy się błędem.
+// Silnik sa-edit sprawdza re-solve: sa(), dzień 0 wolny dla 10 nauczycieli, drugie sa().
+// Portfel musi też odtworzyć sa() z mieszanką ruchów solvera (patrz portfolioKeepsMoves()).
+// --rooms matching przełącza wszystkie silniki na przydział sal skojarzeniem.
+//
+// Użycie: scheduler_bench [--iters N] [--seed N] [--threads N] [--format table|jsonl] [--rooms random|matching]
+//                         [--engines sa,sa-adaptive,sa-edit,tabu,pt,portfolio,decompose] [--cases nazwa,...]
+
+struct BenchCase {
+    string name;
+    function<Instance()> make;
+};
+
+struct BenchResult {
+    size_t vars = 0;
+    long long iters = -1;  // -1: silnik nie podaje liczby iteracji
+    double secs = 0;
+    int cost = 0;
+    long peakKb = 0;
+};
+
+static vector<BenchCase> benchCases() {
+    auto school = [](int classes, int days, int periods, double tightness, int splits, int perTeacher,
+                     double availability, int doubles = 0) {
+        return [=] {
+            GenParams p;
+            p.classes = classes;
+            p.days = days;
+            p.periods = periods;
+            p.tightness = tightness;
+            p.splits = splits;
+            p.classesPerTeacher = perTeacher;
+            p.availability = availability;
+            p.doubles = doubles;
+            return generateSchool(p);
+        };
+    };
+    return {
+        {"na-styk-25", [] { return generateNaStyk(25); }},   // instancja z main(), niewykonalna
+        {"na-styk-175", [] { return generateNaStyk(175); }}, // ~2100 lekcji, niewykonalna
+        {"school-30", school(30, 5, 6, 0.95, 1, 3, 1.0)},
+        {"school-120-split", school(120, 5, 6, 0.95, 3, 4, 1.0)},
+        {"school-400-avail", school(400, 5, 6, 0.95, 2, 3, 0.9)},
+        {"school-120-doubles", school(120, 5, 6, 0.95, 3, 4, 1.0, 3)}, // Fizyka, WF, Biologia w parach
+    };
+}
+
+static vector<string> splitList(const string& s) {
+    vector<string> out;
+    stringstream ss(s);
+    for (string x; getline(ss, x, ',');) if (!x.empty()) out.push_back(x);
+    return out;
+}
+
+// Portfel z jednym uczestnikiem to sa() z harmonogramem main() i mieszanką ruchów solvera (room
+// i freeRoom jak domyślne), więc daje ten sam plan co sa() z seedem tego uczestnika. Inny plan
+// znaczy, że portfel gubi część ustawień ruchów, np. matchRooms.
+static bool portfolioKeepsMoves(const BenchCase& c, int iters, uint32_t seed, bool matchRooms) {
+    Instance in = c.make();
+    Solver solver(in.slots, in.lessons, in.rooms, in.domains, (int)in.groupName.size(), (int)in.teacherName.size());
+    solver.moves.matchRooms = matchRooms;
+    PortfolioParams p;
+    p.workers = 1;
+    p.maxIters = iters;
+    p.seed = seed;
+    Solver ref = solver;
+    ref.rng.seed(portfolioEntries(p, ref.moves)[0].seed);
+    ref.buildInitial();
+    ref.sa(iters, 2.5, 0.99995);
+    portfolioSolve(solver, p);
+    return solver.bestAssign == ref.bestAssign && solver.bestAssignRooms == ref.bestAssignRooms;
+}
+
+// Tabu ocenia w iteracji kilka lekcji razy wszystkie ich sloty, więc dostaje 1/20 budżetu sa().
+static BenchResult runEngine(const BenchCase& c, const string& engine, int iters, uint32_t seed, int threads,
+                             bool matchRooms) {
+    BenchResult res;
+    Instance in = c.make();
+    Solver solver(in.slots, in.lessons, in.rooms, in.domains, (int)in.groupName.size(), (int)in.teacherName.size());
+    solver.rng.seed(seed);
+    solver.moves.matchRooms = matchRooms;
+    res.vars = solver.vars.size();
+
+    auto t0 = chrono::steady_clock::now();
+    if (engine == "portfolio") {
+        PortfolioParams p;
+        p.workers = threads;
+        p.maxIters = iters;
+        p.seed = seed;
+        portfolioSolve(solver, p);
+    } else if (engine == "decompose") {
+        DecomposeParams p;
+        p.workers = threads;
+        p.maxIters = iters;
+        p.seed = seed;
+        decomposeSolve(solver, p);
+    } else {
+        solver.buildInitial();
+        if (engine == "sa") {
+            res.iters = solver.sa(iters, 2.5, 0.99995);
+        } else if (engine == "sa-edit") {
+            res.iters = solver.sa(iters, 2.5, 0.99995);
+            vector<int> day0;
+            for (int s = 0; s < solver.numSlots; ++s) if (in.slots[s].day == 0) day0.push_back(s);
+            for (int t = 0; t < min(10, solver.numTeachers); ++t) solver.blockTeacher(t, day0);
+            res.iters += solver.sa(iters, 0.5, 0.9999);
+        } else if (engine == "sa-adaptive") {
+            Cooling c;
+            c.maxIters = iters;
+            res.iters = solver.saAdaptive(c);
+        } else if (engine == "tabu") {
+            res.iters = solver.tabu(max(1, iters / 20));
+        } else if (engine == "pt") {
+            TemperingParams p;
+            p.replicas = 4;
+            p.threads = threads;
+            p.maxIters = iters;
+            p.seed = seed;
+            res.iters = parallelTempering(solver, p) * p.replicas;
+        }
+    }
+    res.secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    res.cost = solver.bestCost;
+    ostringstream report;
+    if ((res.cost == 0) != solver.verify_and_report(report)) {
+        cerr << "[ERR] " << c.name << "/" << engine << ": koszt " << res.cost << ", a " << report.str();
+        _exit(1);
+    }
+    if (engine == "portfolio" && !portfolioKeepsMoves(c, min(iters, 200000), seed, matchRooms)) {
+        cerr << "[ERR] " << c.name << "/portfolio: uczestnik nie używa mieszanki ruchów solvera\n";
+        _exit(1);
+    }
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    res.peakKb = ru.ru_maxrss;
+    return res;
+}
+
+int main(int argc, char** argv) {
+    int iters = 1200000;
+    uint32_t seed = 12345;
+    int threads = max(1u, thread::hardware_concurrency());
+    string format = "table";
+    vector<string> engines = {"sa", "sa-adaptive", "sa-edit", "tabu", "pt", "portfolio", "decompose"};
+    vector<string> only;
+    bool failed = false;
+    bool matchRooms = false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string opt = argv[i], val = argv[i + 1];
+        if (opt == "--iters") iters = stoi(val);
+        else if (opt == "--seed") seed = stoul(val);
+        else if (opt == "--threads") threads = stoi(val);
+        else if (opt == "--format") format = val;
+        else if (opt == "--engines") engines = splitList(val);
+        else if (opt == "--cases") only = splitList(val);
+        else if (opt == "--rooms") {
+            if (val != "random" && val != "matching") { cerr << "[ERR] nieznany tryb sal: " << val << "\n"; return 1; }
+            matchRooms = val == "matching";
+        }
+        else { cerr << "Nieznana opcja: " << opt << "\n"; return 1; }
+    }
+
+    if (format == "table") {
+        printf("%-18s %-10s %8s %10s %9s %12s %9s %7s %9s\n", "instancja", "silnik", "zmienne", "iteracje", "czas[s]",
+               "it/s", "do 0[s]", "koszt", "RSS[KB]");
+    }
+    for (const BenchCase& c : benchCases()) {
+        if (!only.empty() && find(only.begin(), only.end(), c.name) == only.end()) continue;
+        for (const string& engine : engines) {
+            int fd[2];
+            if (pipe(fd) != 0) return 1;
+            fflush(stdout);
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(fd[0]);
+                BenchResult r = runEngine(c, engine, iters, seed, threads, matchRooms);
+                ssize_t w = write(fd[1], &r, sizeof r);
+                _exit(w == sizeof r ? 0 : 1);
+            }
+            close(fd[1]);
+            BenchResult r;
+            bool ok = read(fd[0], &r, sizeof r) == sizeof r;
+            close(fd[0]);
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                cerr << "[ERR] " << c.name << "/" << engine << " nie zakończył się poprawnie\n";
+                failed = true;
+                continue;
+            }
+
+            double itps = r.iters >= 0 && r.secs > 0 ? r.iters / r.secs : -1;
+            double ttf = r.cost == 0 ? r.secs : -1;
+            if (format == "jsonl") {
+                printf("{\"case\":\"%s\",\"engine\":\"%s\",\"seed\":%u,\"vars\":%zu,\"iters\":", c.name.c_str(),
+                       engine.c_str(), seed, r.vars);
+                if (r.iters >= 0) printf("%lld", r.iters); else printf("null");
+                printf(",\"secs\":%.4f,\"it_per_s\":", r.secs);
+                if (itps >= 0) printf("%.0f", itps); else printf("null");
+                printf(",\"time_to_feasible\":");
+                if (ttf >= 0) printf("%.4f", ttf); else printf("null");
+                printf(",\"cost\":%d,\"peak_rss_kb\":%ld}\n", r.cost, r.peakKb);
+            } else {
+                printf("%-18s %-10s %8zu ", c.name.c_str(), engine.c_str(), r.vars);
+                if (r.iters >= 0) printf("%10lld ", r.iters); else printf("%10s ", "-");
+                printf("%9.3f ", r.secs);
+                if (itps >= 0) printf("%12.0f ", itps); else printf("%12s ", "-");
+                if (ttf >= 0) printf("%9.3f ", ttf); else printf("%9s ", "-");
+                printf("%7d %9ld\n", r.cost, r.peakKb);
+            }
+        }
+    }
+    return failed ? 1 : 0;
+}
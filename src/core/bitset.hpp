@@ -0,0 +1,82 @@
+#ifndef BITSET_HPP_
+#define BITSET_HPP_
+
+#include <bits/stdc++.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+// Operacje na zbiorach bitów zapisanych w słowach 64-bitowych. Jądra any*/popcount* działają
+// na przedziale słów [lo, hi), dzięki czemu zbiory o małym rozrzucie (np. sale jednego typu,
+// podgrupy jednej klasy) kosztują jedno-dwa słowa niezależnie od rozmiaru instancji.
+namespace bits {
+
+inline int words(int n) { return (n + 63) >> 6; }
+inline bool test(const uint64_t* w, int i) { return (w[i >> 6] >> (i & 63)) & 1; }
+inline void set(uint64_t* w, int i) { w[i >> 6] |= uint64_t(1) << (i & 63); }
+inline void reset(uint64_t* w, int i) { w[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+
+// Przedział słów zawierający wszystkie ustawione bity zbioru.
+struct Span { int lo = 0, hi = 0; };
+
+inline Span span(const uint64_t* w, int n) {
+    Span sp;
+    while (sp.lo < n && !w[sp.lo]) sp.lo++;
+    sp.hi = n;
+    while (sp.hi > sp.lo && !w[sp.hi - 1]) sp.hi--;
+    return sp;
+}
+
+// (a & b) != 0
+inline bool anyAnd(const uint64_t* a, const uint64_t* b, Span sp) {
+    int i = sp.lo;
+#if defined(__AVX2__)
+    for (; i + 4 <= sp.hi; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        if (!_mm256_testz_si256(x, y)) return true;
+    }
+#endif
+    for (; i < sp.hi; ++i) if (a[i] & b[i]) return true;
+    return false;
+}
+
+// (a & ~b) != 0
+inline bool anyAndNot(const uint64_t* a, const uint64_t* b, Span sp) {
+    int i = sp.lo;
+#if defined(__AVX2__)
+    for (; i + 4 <= sp.hi; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        if (!_mm256_testc_si256(y, x)) return true;
+    }
+#endif
+    for (; i < sp.hi; ++i) if (a[i] & ~b[i]) return true;
+    return false;
+}
+
+// |a & ~b|
+inline int popcountAndNot(const uint64_t* a, const uint64_t* b, Span sp) {
+    int c = 0;
+    for (int i = sp.lo; i < sp.hi; ++i) c += __builtin_popcountll(a[i] & ~b[i]);
+    return c;
+}
+
+// Indeks k-tego (od zera) ustawionego bitu w a & ~b; -1, gdy takiego nie ma.
+inline int selectAndNot(const uint64_t* a, const uint64_t* b, Span sp, int k) {
+    for (int i = sp.lo; i < sp.hi; ++i) {
+        uint64_t w = a[i] & ~b[i];
+        int c = __builtin_popcountll(w);
+        if (k < c) {
+            while (k--) w &= w - 1;
+            return (i << 6) + __builtin_ctzll(w);
+        }
+        k -= c;
+    }
+    return -1;
+}
+
+} // namespace bits
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef CHECKPOINT_HPP_
+#define CHECKPOINT_HPP_
+
+#include "solver.hpp"
+
+/// ====== PUNKTY KONTROLNE I START OD GOTOWEGO PLANU ======
+//
+// Punkt kontrolny (magic "SCHK") to stan przerwanego sa(): liczba zmiennych, iteracja,
+// odstęp między punktami (checkpointEvery), temperatura, najlepszy koszt, stan generatora
+// losowego (tekst operator<< SolverRng), a potem po int32: slotOf, roomOf, bestAssign, bestAssignRooms. Zapis idzie do pliku
+// tymczasowego i rename(), więc przerwanie w trakcie zapisu zostawia poprzedni punkt.
+
+namespace checkpoint {
+
+constexpr char MAGIC[4] = {'S', 'C', 'H', 'K'};
+constexpr int32_t VERSION = 2;
+
+template <class T> void put(ostream& out, T v) { out.write((const char*)&v, sizeof v); }
+template <class T> bool get(istream& in, T& v) { return (bool)in.read((char*)&v, sizeof v); }
+
+inline void putInts(ostream& out, const vector<int>& a) {
+    out.write((const char*)a.data(), a.size() * sizeof(int));
+}
+inline bool getInts(istream& in, vector<int>& a, int n) {
+    a.resize(n);
+    return (bool)in.read((char*)a.data(), n * sizeof(int));
+}
+
+} // namespace checkpoint
+
+inline bool saveCheckpoint(const Solver& S, int iter, double T, const string& path, ostream& os = cerr) {
+    using namespace checkpoint;
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp, ios::binary);
+        if (!out) {
+            os << "[ERR] nie można zapisać " << tmp << "\n";
+            return false;
+        }
+        ostringstream rs;
+        rs << S.rng;
+        string rng = rs.str();
+        out.write(MAGIC, 4);
+        put<int32_t>(out, VERSION);
+        put<int32_t>(out, S.vars.size());
+        put<int32_t>(out, iter);
+        put<int32_t>(out, S.checkpointEvery);
+        put<double>(out, T);
+        put<int32_t>(out, S.bestCost);
+        put<int32_t>(out, rng.size());
+        out.write(rng.data(), rng.size());
+        putInts(out, S.slotOf);
+        putInts(out, S.roomOf);
+        putInts(out, S.bestAssign);
+        putInts(out, S.bestAssignRooms);
+        if (!out.flush()) {
+            os << "[ERR] błąd zapisu " << tmp << "\n";
+            return false;
+        }
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        os << "[ERR] nie można podmienić " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Przywraca stan solvera z punktu kontrolnego; iter i T posłużą do wznowienia sa(..., T, alpha, iter).
+// Odtwarza też checkpointEvery - z tym samym odstępem wznowiony przebieg powtarza przerwany.
+inline bool loadCheckpoint(Solver& S, int& iter, double& T, const string& path, ostream& os = cerr) {
+    using namespace checkpoint;
+    ifstream in(path, ios::binary);
+    auto fail = [&](const string& why) {
+        os << "[ERR] punkt kontrolny " << path << ": " << why << "\n";
+        return false;
+    };
+    if (!in) return fail("nie można otworzyć");
+    char magic[4];
+    int32_t version, nVars, it, every, best, rngLen;
+    double temp;
+    if (!in.read(magic, 4) || memcmp(magic, MAGIC, 4) != 0) return fail("to nie jest punkt kontrolny");
+    if (!get(in, version) || version != VERSION) return fail("nieobsługiwana wersja");
+    if (!get(in, nVars) || nVars != (int)S.vars.size()) return fail("inna liczba zmiennych niż w instancji");
+    if (!get(in, it) || !get(in, every) || !get(in, temp) || !get(in, best) || !get(in, rngLen) || rngLen < 0)
+        return fail("ucięty plik");
+    string rng(rngLen, '\0');
+    if (!in.read(rng.data(), rngLen)) return fail("ucięty plik");
+    vector<int> slotOf, roomOf, bestAssign, bestAssignRooms;
+    if (!getInts(in, slotOf, nVars) || !getInts(in, roomOf, nVars) || !getInts(in, bestAssign, nVars) ||
+        !getInts(in, bestAssignRooms, nVars))
+        return fail("ucięty plik");
+    for (int v = 0; v < nVars; ++v) {
+        for (int s : { slotOf[v], bestAssign[v] }) if (s < 0 || s >= S.numSlots) return fail("slot poza zakresem");
+        for (int r : { roomOf[v], bestAssignRooms[v] }) if (r < 0 || r >= S.numRooms) return fail("sala poza zakresem");
+    }
+    istringstream rs(rng);
+    if (!(rs >> S.rng)) return fail("uszkodzony stan generatora");
+
+    S.slotOf = move(slotOf);
+    S.roomOf = move(roomOf);
+    S.rebuild();
+    S.bestAssign = move(bestAssign);
+    S.bestAssignRooms = move(bestAssignRooms);
+    S.bestCost = best;
+    S.checkpointEvery = every;
+    iter = it;
+    T = temp;
+    return true;
+}
+
+// Wczytuje plan zapisany przez exportTimetable(..., ExportFormat::Binary) jako start dla
+// buildFrom(): kolejne przydziały lekcji l trafiają do kolejnych jej godzin. Lekcje spoza
+// instancji są pomijane, a godziny bez przydziału dostają -1.
+inline bool loadTimetable(const Solver& S, const string& path, vector<int>& slot, vector<int>& room,
+                          ostream& os = cerr) {
+    using checkpoint::get;
+    ifstream in(path, ios::binary);
+    auto fail = [&](const string& why) {
+        os << "[ERR] plan " << path << ": " << why << "\n";
+        return false;
+    };
+    if (!in) return fail("nie można otworzyć");
+    char magic[4];
+    int32_t version, n;
+    if (!in.read(magic, 4) || memcmp(magic, "SCHA", 4) != 0) return fail("to nie jest plan binarny");
+    if (!get(in, version) || version != 1 || !get(in, n) || n < 0) return fail("uszkodzony nagłówek");
+
+    vector<int> firstVar(S.lessons.size() + 1, 0), next;
+    for (const Variable& x : S.vars) firstVar[x.lessonIdx + 1]++;
+    for (int l = 0; l < (int)S.lessons.size(); ++l) firstVar[l + 1] += firstVar[l];
+    next.assign(firstVar.begin(), firstVar.end() - 1);
+    slot.assign(S.vars.size(), -1);
+    room.assign(S.vars.size(), -1);
+    for (int i = 0; i < n; ++i) {
+        int32_t a[3];
+        if (!in.read((char*)a, sizeof a)) return fail("ucięty plik");
+        int l = a[0];
+        if (l < 0 || l >= (int)S.lessons.size() || next[l] == firstVar[l + 1]) continue;
+        slot[next[l]] = a[1];
+        room[next[l]] = a[2];
+        next[l]++;
+    }
+    return true;
+}
+
+#endif
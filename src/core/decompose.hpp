@@ -0,0 +1,142 @@
+#ifndef DECOMPOSE_HPP_
+#define DECOMPOSE_HPP_
+
+#include "solver.hpp"
+
+/// ====== DEKOMPOZYCJA NA SKŁADOWE ======
+//
+// Dwie lekcje muszą stać w różnych slotach, gdy mają wspólnego nauczyciela, wspólną grupę albo
+// grupa jednej koliduje z grupą drugiej. Składowe spójne tego grafu (union-find po węzłach
+// lekcji, nauczycieli i grup) rozwiązujemy osobno i równolegle; między sobą dzielą co najwyżej
+// sale. Składowa startująca widzi sale zajęte przez składowe już rozwiązane jak blokady, więc
+// kolidować mogą tylko składowe liczone w tej samej chwili. Resztę usuwa koordynacja po scaleniu:
+// skojarzenie sal w każdym slocie (matchAllRooms()) i krótkie sa() w niskiej temperaturze.
+// Z rooms == true wspólna lista sal też łączy lekcje - składowe są wtedy w pełni niezależne.
+// Budżet maxIters dzielimy między składowe proporcjonalnie do godzin, co najmniej minIters na każdą.
+
+struct DecomposeParams {
+    int workers = max(1u, thread::hardware_concurrency());
+    int maxIters = 1200000;   // łączny budżet sa() składowych
+    int minIters = 20000;     // najmniejszy budżet jednej składowej
+    double T0 = 2.5, alpha = 0.99995;
+    int coordIters = 400000;  // budżet sa() koordynującego
+    double coordT0 = 0.3, coordAlpha = 0.9999;
+    bool rooms = false;
+    uint32_t seed = 12345;
+};
+
+struct DisjointSets {
+    vector<int> parent;
+
+    explicit DisjointSets(int n) : parent(n) { iota(parent.begin(), parent.end(), 0); }
+    int find(int x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    }
+    void unite(int a, int b) { parent[find(a)] = find(b); }
+};
+
+// Lekcje (z godzinami) każdej składowej, od największej liczby godzin.
+inline vector<vector<int>> lessonComponents(const Solver& S, bool rooms) {
+    const int L = S.lessons.size(), T = S.numTeachers, G = S.numGroups;
+    // Węzły: lekcje, nauczyciele, grupy, sale.
+    DisjointSets ds(L + T + G + (rooms ? S.numRooms : 0));
+    for (int l = 0; l < L; ++l) {
+        const Lesson& X = S.lessons[l];
+        if (X.hours == 0) continue;
+        ds.unite(l, L + X.teacher);
+        ds.unite(l, L + T + X.group);
+        for (int g : S.collDomain(l)) ds.unite(l, L + T + g);
+        if (rooms) for (int r : S.roomDomain(l)) ds.unite(l, L + T + G + r);
+    }
+    map<int, int> index;
+    vector<vector<int>> comps;
+    vector<int> hours;
+    for (int l = 0; l < L; ++l) {
+        if (S.lessons[l].hours == 0) continue;
+        auto [it, fresh] = index.try_emplace(ds.find(l), (int)comps.size());
+        if (fresh) comps.emplace_back(), hours.push_back(0);
+        comps[it->second].push_back(l);
+        hours[it->second] += S.lessons[l].hours;
+    }
+    vector<int> order(comps.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return hours[a] > hours[b]; });
+    vector<vector<int>> out;
+    for (int c : order) out.push_back(move(comps[c]));
+    return out;
+}
+
+// Rozwiązuje składowe na p.workers wątkach (największe najpierw), każdą osobnym solverem z lekcjami
+// składowej, bieżącymi domenami i blokadami solvera oraz salami zajętymi przez gotowe składowe.
+// Scalony plan trafia do solvera przez buildFrom(), po czym koordynacja usuwa konflikty sal.
+// Przerwanie i termin solvera widzi też sa() każdej składowej; składowe niezaczęte przed
+// przerwaniem buildFrom() rozmieszcza zachłannie.
+// Zwraca liczbę składowych.
+inline int decomposeSolve(Solver& solver, const DecomposeParams& p) {
+    vector<vector<int>> comps = lessonComponents(solver, p.rooms);
+    vector<int> slot(solver.vars.size(), -1), room(solver.vars.size(), -1);
+    Occupancy taken = solver.pinned;
+    mutex takenLock;
+    long long totalHours = 0;
+    for (const Lesson& L : solver.lessons) totalHours += L.hours;
+
+    auto solveComponent = [&](int c) {
+        vector<Lesson> les;
+        long long hours = 0;
+        for (int l : comps[c]) {
+            hours += solver.lessons[l].hours;
+            Lesson X = solver.lessons[l];
+            X.id = les.size();
+            X.possibleSlots = solver.slotSetOf[l];
+            X.possibleRooms = solver.roomSetOf[l];
+            X.colidingGroups = solver.collSetOf[l];
+            les.push_back(X);
+        }
+        Solver sub(solver.allSlots, les, solver.rooms, solver.dom, solver.numGroups, solver.numTeachers);
+        {
+            lock_guard<mutex> lock(takenLock);
+            sub.pinned = taken;
+        }
+        sub.moves = solver.moves;
+        sub.deadline = solver.deadline;
+        SharedProgress progress;
+        progress.parent = solver.shared;
+        sub.shared = &progress;
+        seed_seq sq{p.seed, (uint32_t)c};
+        sub.rng.seed(sq);
+        sub.buildInitial();
+        sub.sa(max<long long>(p.minIters, p.maxIters * hours / max(1LL, totalHours)), p.T0, p.alpha);
+        // Zmienne lekcji leżą w obu solverach kolejno, więc godziny przechodzą jeden do jednego.
+        lock_guard<mutex> lock(takenLock);
+        for (int k = 0; k < (int)comps[c].size(); ++k) {
+            int to = solver.varsOf(comps[c][k]).first, from = sub.varsOf(k).first;
+            for (int i = 0; i < les[k].hours; ++i) {
+                slot[to + i] = sub.bestAssign[from + i];
+                room[to + i] = sub.bestAssignRooms[from + i];
+                taken.addRoom(slot[to + i], room[to + i], 1);
+            }
+        }
+    };
+
+    atomic<int> next{0};
+    vector<thread> pool;
+    for (int w = 0; w < min<int>(max(1, p.workers), comps.size()); ++w) {
+        pool.emplace_back([&] {
+            while (!solver.cancelled()) {
+                int c = next.fetch_add(1);
+                if (c >= (int)comps.size()) break;
+                solveComponent(c);
+            }
+        });
+    }
+    for (auto& t : pool) t.join();
+
+    solver.buildFrom(slot, room);
+    solver.matchAllRooms();
+    if (solver.curCost < solver.bestCost) solver.saveBest();
+    if (solver.bestCost > 0 && !solver.cancelled()) solver.sa(p.coordIters, p.coordT0, p.coordAlpha);
+    return comps.size();
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef EXPORT_HPP_
+#define EXPORT_HPP_
+
+#include "generator.hpp"
+
+/// ====== EKSPORT PLANU ======
+//
+// Przydziały są czytane wprost z bestAssign/bestAssignRooms i pisane strumieniowo przez
+// bufor z to_chars - bez składania napisów dla wpisów. Formaty:
+//   text   - siatka jak dotąd (Dzien d | Lekcja p : wpis | wpis ...); grupa i nauczyciel we wpisie
+//            jak dotąd po numerze (G<nr>, T<nr>), nazwy są w nagłówkach sekcji i w csv/jsonl
+//   csv    - nagłówek i wiersz na przydział: day,period,group,subject,teacher,room
+//   jsonl  - obiekt JSON na wiersz z tymi samymi polami
+//   binary - "SCHA", wersja, liczba przydziałów, potem (lekcja, slot, sala) po int32;
+//            nazwy i dni/lekcje bierze się z pliku instancji
+// Widok ustala kolejność: slot (slot, potem kolejność lekcji) albo teacher/group/room
+// (najpierw nauczyciel/grupa/sala, w obrębie - slot). Tekst dla widoków dzieli plan na sekcje.
+
+enum class ExportFormat { Text, Csv, Jsonl, Binary };
+enum class ExportView { Slot, Teacher, Group, Room };
+
+namespace exporter {
+
+// Bufor wyjściowy opróżniany do ostream porcjami po 64 KiB.
+struct Sink {
+    ostream& os;
+    vector<char> buf;
+    size_t n = 0;
+
+    explicit Sink(ostream& o) : os(o), buf(1 << 16) {}
+    ~Sink() { flush(); }
+
+    void flush() {
+        os.write(buf.data(), n);
+        n = 0;
+    }
+    void reserve(size_t k) {
+        if (n + k > buf.size()) flush();
+        if (k > buf.size()) buf.resize(k);
+    }
+    void put(char c) {
+        reserve(1);
+        buf[n++] = c;
+    }
+    void put(string_view s) {
+        reserve(s.size());
+        memcpy(buf.data() + n, s.data(), s.size());
+        n += s.size();
+    }
+    void put(int v) {
+        reserve(12);
+        n = to_chars(buf.data() + n, buf.data() + buf.size(), v).ptr - buf.data();
+    }
+    void raw(int32_t v) {
+        reserve(4);
+        memcpy(buf.data() + n, &v, 4);
+        n += 4;
+    }
+    // Pole CSV - w cudzysłowie tylko, gdy zawiera przecinek, cudzysłów lub nową linię.
+    void csv(string_view s) {
+        if (s.find_first_of(",\"\n") == string_view::npos) return put(s);
+        put('"');
+        for (char c : s) {
+            if (c == '"') put('"');
+            put(c);
+        }
+        put('"');
+    }
+    void json(string_view s) {
+        put('"');
+        for (char c : s) {
+            if (c == '"' || c == '\\') put('\\'), put(c);
+            else if ((unsigned char)c < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                put("\\u00");
+                put(hex[c >> 4]);
+                put(hex[c & 15]);
+            } else put(c);
+        }
+        put('"');
+    }
+};
+
+// Kolejność zmiennych dla widoku: stabilne sortowanie kubełkowe po slocie, potem po kluczu widoku.
+inline vector<int> order(const Solver& S, ExportView view, int& keys, vector<int>& keyOf) {
+    const int V = S.vars.size();
+    auto bucket = [&](const vector<int>& in, int K, auto key) {
+        vector<int> start(K + 1, 0), out(in.size());
+        for (int v : in) start[key(v) + 1]++;
+        for (int k = 0; k < K; ++k) start[k + 1] += start[k];
+        for (int v : in) out[start[key(v)]++] = v;
+        return out;
+    };
+    vector<int> all(V);
+    iota(all.begin(), all.end(), 0);
+    vector<int> bySlot = bucket(all, S.numSlots, [&](int v) { return S.bestAssign[v]; });
+
+    keyOf.assign(V, 0);
+    keys = 1;
+    for (int v = 0; v < V; ++v) {
+        const Lesson& L = S.lessons[S.vars[v].lessonIdx];
+        switch (view) {
+        case ExportView::Slot: break;
+        case ExportView::Teacher: keyOf[v] = L.teacher; keys = S.numTeachers; break;
+        case ExportView::Group: keyOf[v] = L.group; keys = S.numGroups; break;
+        case ExportView::Room: keyOf[v] = S.bestAssignRooms[v]; keys = S.numRooms; break;
+        }
+    }
+    if (view == ExportView::Slot) return bySlot;
+    return bucket(bySlot, keys, [&](int v) { return keyOf[v]; });
+}
+
+} // namespace exporter
+
+inline bool parseExportFormat(const string& s, ExportFormat& f) {
+    if (s == "text") f = ExportFormat::Text;
+    else if (s == "csv") f = ExportFormat::Csv;
+    else if (s == "jsonl") f = ExportFormat::Jsonl;
+    else if (s == "binary") f = ExportFormat::Binary;
+    else return false;
+    return true;
+}
+
+inline bool parseExportView(const string& s, ExportView& v) {
+    if (s == "slot") v = ExportView::Slot;
+    else if (s == "teacher") v = ExportView::Teacher;
+    else if (s == "group") v = ExportView::Group;
+    else if (s == "room") v = ExportView::Room;
+    else return false;
+    return true;
+}
+
+// Zapisuje najlepszy plan solvera (bestAssign/bestAssignRooms) w wybranym formacie i widoku.
+inline void exportTimetable(const Instance& in, const Solver& S, ostream& os,
+                            ExportFormat format = ExportFormat::Text, ExportView view = ExportView::Slot) {
+    int keys;
+    vector<int> keyOf;
+    vector<int> ord = exporter::order(S, view, keys, keyOf);
+    exporter::Sink out(os);
+
+    auto entry = [&](int v) {
+        const Lesson& L = S.lessons[S.vars[v].lessonIdx];
+        out.put('G');
+        out.put(L.group);
+        out.put(' ');
+        out.put(in.subjectName[L.subject]);
+        out.put(" (T");
+        out.put(L.teacher);
+        out.put("), ");
+        out.put(S.rooms[S.bestAssignRooms[v]].roomName);
+    };
+    auto slotLine = [&](int s) {
+        out.put("Dzien ");
+        out.put(in.slots[s].day);
+        out.put(" | Lekcja ");
+        out.put(in.slots[s].period);
+        out.put(" : ");
+    };
+
+    switch (format) {
+    case ExportFormat::Text: {
+        if (view == ExportView::Slot) {
+            size_t i = 0;
+            for (int s = 0; s < S.numSlots; ++s) {
+                slotLine(s);
+                if (i == ord.size() || S.bestAssign[ord[i]] != s) { out.put("-\n"); continue; }
+                for (bool first = true; i < ord.size() && S.bestAssign[ord[i]] == s; ++i, first = false) {
+                    if (!first) out.put(" | ");
+                    entry(ord[i]);
+                }
+                out.put('\n');
+            }
+            break;
+        }
+        const vector<string>& names = view == ExportView::Teacher ? in.teacherName : in.groupName;
+        for (size_t i = 0; i < ord.size();) {
+            int k = keyOf[ord[i]];
+            out.put("== ");
+            out.put(view == ExportView::Room ? string_view(S.rooms[k].roomName) : string_view(names[k]));
+            out.put(" ==\n");
+            while (i < ord.size() && keyOf[ord[i]] == k) {
+                int s = S.bestAssign[ord[i]];
+                slotLine(s);
+                for (bool first = true; i < ord.size() && keyOf[ord[i]] == k && S.bestAssign[ord[i]] == s; ++i, first = false) {
+                    if (!first) out.put(" | ");
+                    entry(ord[i]);
+                }
+                out.put('\n');
+            }
+        }
+        break;
+    }
+    case ExportFormat::Csv:
+        out.put("day,period,group,subject,teacher,room\n");
+        for (int v : ord) {
+            const Lesson& L = S.lessons[S.vars[v].lessonIdx];
+            const Slot& sl = in.slots[S.bestAssign[v]];
+            out.put(sl.day);
+            out.put(',');
+            out.put(sl.period);
+            out.put(',');
+            out.csv(in.groupName[L.group]);
+            out.put(',');
+            out.csv(in.subjectName[L.subject]);
+            out.put(',');
+            out.csv(in.teacherName[L.teacher]);
+            out.put(',');
+            out.csv(S.rooms[S.bestAssignRooms[v]].roomName);
+            out.put('\n');
+        }
+        break;
+    case ExportFormat::Jsonl:
+        for (int v : ord) {
+            const Lesson& L = S.lessons[S.vars[v].lessonIdx];
+            const Slot& sl = in.slots[S.bestAssign[v]];
+            out.put("{\"day\":");
+            out.put(sl.day);
+            out.put(",\"period\":");
+            out.put(sl.period);
+            out.put(",\"group\":");
+            out.json(in.groupName[L.group]);
+            out.put(",\"subject\":");
+            out.json(in.subjectName[L.subject]);
+            out.put(",\"teacher\":");
+            out.json(in.teacherName[L.teacher]);
+            out.put(",\"room\":");
+            out.json(S.rooms[S.bestAssignRooms[v]].roomName);
+            out.put("}\n");
+        }
+        break;
+    case ExportFormat::Binary:
+        out.put("SCHA");
+        out.raw(1);
+        out.raw((int32_t)ord.size());
+        for (int v : ord) {
+            out.raw(S.vars[v].lessonIdx);
+            out.raw(S.bestAssign[v]);
+            out.raw(S.bestAssignRooms[v]);
+        }
+        break;
+    }
+}
+
+#endif
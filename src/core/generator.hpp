@@ -0,0 +1,245 @@
+#ifndef GENERATOR_HPP_
+#define GENERATOR_HPP_
+
+#include "solver.hpp"
+
+struct Instance {
+    vector<Slot> slots;
+    vector<Room> rooms;
+    vector<Lesson> lessons;
+    vector<string> groupName;
+    vector<string> teacherName;
+    vector<string> subjectName;
+    Domains domains;
+};
+
+/// ====== GENERATOR "NA STYK" ======
+// Dla CLASSES=25 i 5x5 slotów daje dokładnie instancję z pierwotnego main().
+// Większe CLASSES skalują liczbę sal tak, by pojemność nadal równała się popytowi.
+inline Instance generateNaStyk(int CLASSES = 25, int DAYS = 5, int PERIODS = 5) {
+    Instance in;
+    vector<Slot>& slots = in.slots;
+    slots.reserve(DAYS * PERIODS);
+    for (int d = 0; d < DAYS; ++d)
+        for (int p = 0; p < PERIODS; ++p)
+            slots.push_back({ (int)slots.size(), d, p });
+
+    // Sale - dobrane tak, by pojemność == popyt (godziny danego typu na klasę * klasy / sloty)
+    vector<Room>& rooms = in.rooms;
+    auto addRooms = [&](int hoursPerClass, int cap, string base) {
+        int cnt = (hoursPerClass * CLASSES + (int)slots.size() - 1) / (int)slots.size();
+        for (int i = 0; i < cnt; ++i)
+            rooms.push_back({ (int)rooms.size(), cap, base + to_string(i) });
+    };
+    addRooms(5,  30, "Math-"); // 5 * 25 = 125
+    addRooms(10, 28, "Gen-");  // 10 * 25 = 250
+    addRooms(5,  22, "Lab-");  // 5 * 25 = 125
+    addRooms(3,  36, "Gym-");  // 3 * 25 = 75
+    addRooms(6,  24, "Lang-"); // 6 * 25 = 150
+
+    vector<string>& groupName = in.groupName;
+    groupName.reserve(CLASSES * 3);
+    for (int c = 0; c < CLASSES; ++c) {
+        string cname = "C" + to_string(c + 1);
+        groupName.push_back(cname);           // FULL
+        groupName.push_back(cname + "_G1");   // G1
+        groupName.push_back(cname + "_G2");   // G2
+    }
+
+    // Nauczyciele: dla prostoty każdy przedmiot ma własną pulę po CLASSES osób (po 1 na klasę)
+    const int TEACHERS = 12 * CLASSES; // 12 "przedmiotów" wg poniższego przypisania
+    vector<string>& teacherName = in.teacherName;
+    teacherName.resize(TEACHERS);
+    for (int t = 0; t < TEACHERS; ++t) teacherName[t] = "T" + to_string(t);
+
+    // Wygodne indeksowanie: dla każdego przedmiotu zakres długości CLASSES
+    auto Tmath = [&](int c){ return 0*CLASSES + c; };
+    auto Tpol  = [&](int c){ return 1*CLASSES + c; };
+    auto Thist = [&](int c){ return 2*CLASSES + c; };
+    auto Tphys = [&](int c){ return 3*CLASSES + c; };
+    auto Tbio  = [&](int c){ return 4*CLASSES + c; };
+    auto Tpe   = [&](int c){ return 5*CLASSES + c; };
+    auto Ten1  = [&](int c){ return 6*CLASSES + c; };
+    auto Ten2  = [&](int c){ return 7*CLASSES + c; };
+    auto Tict  = [&](int c){ return 8*CLASSES + c; };
+    auto Tgeo  = [&](int c){ return 9*CLASSES + c; };
+    auto Tmus  = [&](int c){ return 10*CLASSES + c; };
+    auto Tart  = [&](int c){ return 11*CLASSES + c; };
+
+    // Domeny slotów – pełne (żeby pojemność zgadzała się z popytem)
+    vector<int> allSlots(slots.size());
+    iota(allSlots.begin(), allSlots.end(), 0);
+    const int ALL_SLOTS = in.domains.slots.add(allSlots);
+
+    // Zbiory sal po typach (indeksy roomId)
+    vector<int> math, lang, lab, gym, gen;
+    for (auto &r : rooms) {
+        if (r.roomName.rfind("Math-", 0) == 0) math.push_back(r.roomId);
+        else if (r.roomName.rfind("Lang-", 0) == 0) lang.push_back(r.roomId);
+        else if (r.roomName.rfind("Lab-", 0) == 0)  lab.push_back(r.roomId);
+        else if (r.roomName.rfind("Gym-", 0) == 0)  gym.push_back(r.roomId);
+        else gen.push_back(r.roomId);
+    }
+    const int MATH_ROOMS = in.domains.rooms.add(math), LANG_ROOMS = in.domains.rooms.add(lang),
+              LAB_ROOMS = in.domains.rooms.add(lab), GYM_ROOMS = in.domains.rooms.add(gym),
+              GEN_ROOMS = in.domains.rooms.add(gen);
+
+    // Lekcje: sumy godzin dobrane tak, by łączne zapotrzebowanie == łączna pojemność
+    vector<Lesson>& lessons = in.lessons;
+    lessons.reserve(CLASSES * 30);
+    map<string, int> subjectId;
+    auto addLesson = [&](int id, int group, int colidingGroups,
+                         int teacher, string subject, int hours,
+                         int slotsIdx, int roomsIdx)
+    {
+        auto it = subjectId.emplace(subject, (int)in.subjectName.size());
+        if (it.second) in.subjectName.push_back(subject);
+        lessons.push_back({id, group, colidingGroups, teacher, it.first->second, hours,
+                           slotsIdx, roomsIdx});
+    };
+
+    int nextId = 0;
+    for (int c = 0; c < CLASSES; ++c) {
+        int FULL = 3*c, G1 = FULL+1, G2 = FULL+2;
+        int CF = in.domains.groups.add({G1, G2}); // FULL koliduje z podgrupami
+        int CG = in.domains.groups.add({FULL});   // każda podgrupa koliduje z FULL
+
+        // Math rooms
+        addLesson(nextId++, FULL, CF, Tmath(c), "Matematyka", 5, ALL_SLOTS, MATH_ROOMS);
+
+        // General rooms
+        addLesson(nextId++, FULL, CF, Tpol(c),  "Polski",     4, ALL_SLOTS, GEN_ROOMS);
+        addLesson(nextId++, FULL, CF, Thist(c), "Historia",   2, ALL_SLOTS, GEN_ROOMS);
+        addLesson(nextId++, FULL, CF, Tgeo(c),  "Geografia",  2, ALL_SLOTS, GEN_ROOMS);
+        addLesson(nextId++, FULL, CF, Tmus(c),  "Muzyka",     1, ALL_SLOTS, GEN_ROOMS);
+        addLesson(nextId++, FULL, CF, Tart(c),  "Plastyka",   1, ALL_SLOTS, GEN_ROOMS);
+
+        // Lab rooms
+        addLesson(nextId++, FULL, CF, Tphys(c), "Fizyka",     2, ALL_SLOTS, LAB_ROOMS);
+        addLesson(nextId++, FULL, CF, Tbio(c),  "Biologia",   2, ALL_SLOTS, LAB_ROOMS);
+        addLesson(nextId++, FULL, CF, Tict(c),  "Informatyka",1, ALL_SLOTS, LAB_ROOMS);
+
+        // Gym rooms
+        addLesson(nextId++, FULL, CF, Tpe(c),   "WF",         3, ALL_SLOTS, GYM_ROOMS);
+
+        // Language rooms (podział na G1/G2)
+        addLesson(nextId++, G1,   CG,  Ten1(c), "Angielski G1", 3, ALL_SLOTS, LANG_ROOMS);
+        addLesson(nextId++, G2,   CG,  Ten2(c), "Angielski G2", 3, ALL_SLOTS, LANG_ROOMS);
+    }
+    return in;
+}
+
+/// ====== GENERATOR PARAMETRYCZNY (benchmarki) ======
+struct GenParams {
+    int classes = 25, days = 5, periods = 6;
+    double tightness = 0.9;     // popyt / pojemność sal każdego typu; 1.0 to "na styk"
+    int splits = 1;             // ile przedmiotów uczy się osobno w podgrupach G1/G2
+    int classesPerTeacher = 1;  // ile klas (podgrup) uczy jeden nauczyciel danego przedmiotu
+    double availability = 1.0;  // ułamek slotów, w których nauczyciel może uczyć
+    int doubles = 0;            // ile przedmiotów ma lekcje podwójne (bloki po 2 godziny)
+    uint32_t seed = 1;
+};
+
+// Siatka przedmiotów jak w generateNaStyk(), ale z regulowanym zapasem sal, liczbą przedmiotów
+// dzielonych na podgrupy, obciążeniem nauczycieli i losową (z seeda) dostępnością nauczycieli.
+// Nauczyciel przedmiotu dostaje classesPerTeacher kolejnych klas; dostępność wyznacza domenę
+// slotów wszystkich jego lekcji. Pierwsze `doubles` przedmiotów z DOUBLE_ORDER ma godziny w parach.
+inline Instance generateSchool(const GenParams& p) {
+    struct Subject { const char* name; int hours; int roomType; };
+    static const Subject SUBJECTS[] = {
+        {"Matematyka", 5, 0}, {"Polski", 4, 1}, {"Historia", 2, 1}, {"Geografia", 2, 1},
+        {"Muzyka", 1, 1},     {"Plastyka", 1, 1}, {"Fizyka", 2, 2}, {"Biologia", 2, 2},
+        {"Informatyka", 1, 2}, {"WF", 3, 3},   {"Angielski", 3, 4},
+    };
+    static const char* ROOM_TYPES[] = {"Math-", "Gen-", "Lab-", "Gym-", "Lang-"};
+    // Kolejność, w jakiej przedmioty przechodzą na podgrupy i na lekcje podwójne (indeksy w SUBJECTS).
+    static const int SPLIT_ORDER[] = {10, 8, 9, 6, 7, 0, 1};
+    static const int DOUBLE_ORDER[] = {6, 9, 7, 1, 0};
+    const int NS = size(SUBJECTS);
+
+    Instance in;
+    mt19937 rng(p.seed);
+    for (int d = 0; d < p.days; ++d)
+        for (int q = 0; q < p.periods; ++q)
+            in.slots.push_back({ (int)in.slots.size(), d, q });
+    const int S = in.slots.size();
+
+    vector<char> split(NS, 0);
+    for (int i = 0; i < min<int>(p.splits, size(SPLIT_ORDER)); ++i) split[SPLIT_ORDER[i]] = 1;
+    vector<int> block(NS, 1);
+    for (int i = 0; i < min<int>(p.doubles, size(DOUBLE_ORDER)); ++i) block[DOUBLE_ORDER[i]] = 2;
+
+    vector<long long> demand(size(ROOM_TYPES), 0);
+    for (int i = 0; i < NS; ++i) demand[SUBJECTS[i].roomType] += (long long)SUBJECTS[i].hours * (split[i] ? 2 : 1) * p.classes;
+    vector<int> roomSet(size(ROOM_TYPES));
+    for (int t = 0; t < (int)size(ROOM_TYPES); ++t) {
+        int cnt = max<long long>(1, ceil(demand[t] / (S * p.tightness)));
+        vector<int> ids;
+        for (int i = 0; i < cnt; ++i) {
+            ids.push_back(in.rooms.size());
+            in.rooms.push_back({ (int)in.rooms.size(), 30, ROOM_TYPES[t] + to_string(i) });
+        }
+        roomSet[t] = in.domains.rooms.add(ids);
+    }
+    // Przedmiot dzielony ma dwie nazwy: "X G1" i "X G2" (subjectOf wskazuje pierwszą).
+    vector<int> subjectOf(NS);
+    for (int i = 0; i < NS; ++i) {
+        subjectOf[i] = in.subjectName.size();
+        if (!split[i]) {
+            in.subjectName.push_back(SUBJECTS[i].name);
+        } else {
+            in.subjectName.push_back(SUBJECTS[i].name + string(" G1"));
+            in.subjectName.push_back(SUBJECTS[i].name + string(" G2"));
+        }
+    }
+
+    vector<int> allSlots(S);
+    iota(allSlots.begin(), allSlots.end(), 0);
+    const int ALL_SLOTS = in.domains.slots.add(allSlots);
+    const int PER = max(1, p.classesPerTeacher);
+    vector<int> teacherDomain;
+    // Nauczyciel k-tej porcji (przedmiot, podgrupa): powstaje przy pierwszej lekcji porcji.
+    map<pair<int, int>, int> teacherOf;
+    auto teacherFor = [&](int c, int subject, int hours) {
+        auto [it, fresh] = teacherOf.try_emplace({subject, c / PER}, (int)in.teacherName.size());
+        if (fresh) {
+            in.teacherName.push_back("T" + to_string(it->second));
+            int dom = ALL_SLOTS;
+            if (p.availability < 1.0) {
+                vector<int> s = allSlots;
+                shuffle(s.begin(), s.end(), rng);
+                s.resize(min<int>(S, max<int>(hours * PER, ceil(p.availability * S))));
+                dom = in.domains.slots.add(s);
+            }
+            teacherDomain.push_back(dom);
+        }
+        return it->second;
+    };
+    auto addLesson = [&](int c, int group, int coll, int subject, int hours, int roomType, int blockLen) {
+        int t = teacherFor(c, subject, hours);
+        in.lessons.push_back({ (int)in.lessons.size(), group, coll, t, subject, hours, teacherDomain[t], roomSet[roomType],
+                               blockLen });
+    };
+
+    for (int c = 0; c < p.classes; ++c) {
+        int FULL = in.groupName.size(), G1 = FULL + 1, G2 = FULL + 2;
+        string cname = "C" + to_string(c + 1);
+        in.groupName.push_back(cname);
+        in.groupName.push_back(cname + "_G1");
+        in.groupName.push_back(cname + "_G2");
+        int CF = in.domains.groups.add({G1, G2});
+        int CG = in.domains.groups.add({FULL});
+        for (int i = 0; i < NS; ++i) {
+            const Subject& sub = SUBJECTS[i];
+            if (!split[i]) {
+                addLesson(c, FULL, CF, subjectOf[i], sub.hours, sub.roomType, block[i]);
+            } else {
+                addLesson(c, G1, CG, subjectOf[i], sub.hours, sub.roomType, block[i]);
+                addLesson(c, G2, CG, subjectOf[i] + 1, sub.hours, sub.roomType, block[i]);
+            }
+        }
+    }
+    return in;
+}
+
+#endif
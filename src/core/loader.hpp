@@ -0,0 +1,438 @@
+#ifndef LOADER_HPP_
+#define LOADER_HPP_
+
+#include "generator.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// ====== WCZYTYWANIE INSTANCJI Z PLIKU ======
+//
+// Format tekstowy - jedna dyrektywa na wiersz, tokeny rozdzielone spacjami/tabulatorami,
+// nazwy ze spacjami w cudzysłowie ("Angielski G1"), '#' zaczyna komentarz do końca wiersza.
+//
+//   days N                           liczba dni
+//   periods N                        liczba lekcji w dniu; sloty to siatka dzień-major (id = d*N + p)
+//   room NAZWA POJEMNOŚĆ             sala
+//   group NAZWA                      grupa (opcjonalnie - grupy i nauczyciele powstają przy pierwszym użyciu)
+//   teacher NAZWA                    nauczyciel (opcjonalnie); kolejność dyrektyw ustala numery T<nr>
+//   collides GRUPA GRUPA...          grupy, z którymi pierwsza nie może mieć lekcji w tym samym slocie
+//   slots ZBIÓR ELEMENT...           nazwany zbiór slotów; element to '*', id slotu, 'd:p' albo 'd:*'
+//   rooms ZBIÓR SALA...              nazwany zbiór sal
+//   lesson GRUPA NAUCZYCIEL PRZEDMIOT GODZINY ZBIÓR_SLOTÓW ZBIÓR_SAL [BLOK]
+//                                    BLOK - godziny idą blokami po tyle kolejnych lekcji (domyślnie 1)
+//
+// Domeny lekcji odwołują się do zbiorów po nazwie, więc każda lista występuje w pliku raz,
+// a w pamięci trafia do Instance::domains. Nazwy sal, grup, nauczycieli i przedmiotów są
+// internowane - lekcje trzymają tylko indeksy.
+//
+// Wariant binarny (magic "SCHB") to te same dane w tablicach int32 gotowych do mmap:
+// nagłówek z licznikami, tablice nazw, pojemności sal, pule domen (sloty, sale, kolidujące
+// grupy) jako listy CSR (przesunięcia + dane), na końcu lekcje po 8 liczb w kolejności pól Lesson
+// (wersja 1 - po 7, bez bloku).
+
+namespace loader {
+
+// Plik zmapowany tylko do odczytu; zwalniany w destruktorze.
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    bool open(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        size = st.st_size;
+        if (size > 0) {
+            void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { ::close(fd); size = 0; return false; }
+            madvise(p, size, MADV_SEQUENTIAL);
+            data = (const char*)p;
+        }
+        ::close(fd);
+        return true;
+    }
+    ~MappedFile() { if (data) munmap((void*)data, size); }
+};
+
+// Nazwy -> kolejne indeksy. Klucze wskazują na vector<string> z nazwami, więc ten nie może
+// się przenosić: rezerwujemy go z góry, a przy przepełnieniu przebudowujemy mapę.
+struct Interner {
+    vector<string>& names;
+    unordered_map<string_view, int> ids;
+
+    explicit Interner(vector<string>& n) : names(n) {
+        for (int i = 0; i < (int)names.size(); ++i) ids.emplace(names[i], i);
+    }
+    int find(string_view s) const {
+        auto it = ids.find(s);
+        return it == ids.end() ? -1 : it->second;
+    }
+    int get(string_view s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) return it->second;
+        if (names.size() == names.capacity()) {
+            names.reserve(max<size_t>(64, names.size() * 2));
+            ids.clear();
+            for (int i = 0; i < (int)names.size(); ++i) ids.emplace(names[i], i);
+        }
+        names.emplace_back(s);
+        ids.emplace(names.back(), (int)names.size() - 1);
+        return (int)names.size() - 1;
+    }
+};
+
+inline bool parseInt(string_view s, int& out) {
+    auto [p, ec] = from_chars(s.data(), s.data() + s.size(), out);
+    return ec == errc() && p == s.data() + s.size();
+}
+
+inline bool loadText(const char* buf, size_t size, Instance& in, ostream& os) {
+    in = Instance();
+    vector<string> roomNames, slotSetNames, roomSetNames;
+    Interner roomIds(roomNames), groupIds(in.groupName), teacherIds(in.teacherName), subjectIds(in.subjectName);
+    Interner slotSetIds(slotSetNames), roomSetIds(roomSetNames);
+    vector<int> slotSets, roomSets; // zbiór z pliku -> lista w in.domains
+    vector<vector<int>> collides;
+    struct Pending { int group, teacher, subject, hours, slotSet, roomSet, block = 1; };
+    vector<Pending> pending;
+    int days = 0, periods = 0;
+
+    const char* p = buf;
+    const char* end = buf + size;
+    int line = 0;
+    vector<string_view> tok;
+    auto fail = [&](const string& why) {
+        os << "[ERR] wiersz " << line << ": " << why << "\n";
+        return false;
+    };
+    auto slotsReady = [&]() {
+        if (!in.slots.empty()) return true;
+        if (days <= 0 || periods <= 0) return false;
+        in.slots.reserve(days * periods);
+        for (int d = 0; d < days; ++d)
+            for (int q = 0; q < periods; ++q)
+                in.slots.push_back({ (int)in.slots.size(), d, q });
+        return true;
+    };
+
+    while (p < end) {
+        line++;
+        tok.clear();
+        while (p < end && *p != '\n') {
+            if (*p == ' ' || *p == '\t' || *p == '\r') { p++; continue; }
+            if (*p == '#') { while (p < end && *p != '\n') p++; break; }
+            if (*p == '"') {
+                const char* b = ++p;
+                while (p < end && *p != '"' && *p != '\n') p++;
+                if (p == end || *p != '"') return fail("niezamknięty cudzysłów");
+                tok.emplace_back(b, p - b);
+                p++;
+            } else {
+                const char* b = p;
+                while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '#') p++;
+                tok.emplace_back(b, p - b);
+            }
+        }
+        if (p < end) p++;
+        if (tok.empty()) continue;
+
+        string_view cmd = tok[0];
+        int n = tok.size();
+        if (cmd == "days" || cmd == "periods") {
+            int v;
+            if (n != 2 || !parseInt(tok[1], v) || v <= 0) return fail("oczekiwano " + string(cmd) + " N");
+            if (!in.slots.empty()) return fail(string(cmd) + " po użyciu slotów");
+            (cmd == "days" ? days : periods) = v;
+        } else if (cmd == "room") {
+            int cap;
+            if (n != 3 || !parseInt(tok[2], cap)) return fail("oczekiwano room NAZWA POJEMNOŚĆ");
+            if (roomIds.find(tok[1]) >= 0) return fail("powtórzona sala " + string(tok[1]));
+            int id = roomIds.get(tok[1]);
+            in.rooms.push_back({ id, cap, string(tok[1]) });
+        } else if (cmd == "group") {
+            if (n != 2) return fail("oczekiwano group NAZWA");
+            groupIds.get(tok[1]);
+        } else if (cmd == "teacher") {
+            if (n != 2) return fail("oczekiwano teacher NAZWA");
+            teacherIds.get(tok[1]);
+        } else if (cmd == "collides") {
+            if (n < 3) return fail("oczekiwano collides GRUPA GRUPA...");
+            int g = groupIds.get(tok[1]);
+            for (int i = 2; i < n; ++i) {
+                int c = groupIds.get(tok[i]);
+                if ((int)collides.size() <= max(g, c)) collides.resize(max(g, c) + 1);
+                collides[g].push_back(c);
+            }
+        } else if (cmd == "slots") {
+            if (n < 3) return fail("oczekiwano slots ZBIÓR ELEMENT...");
+            if (!slotsReady()) return fail("slots przed days/periods");
+            if (slotSetIds.find(tok[1]) >= 0) return fail("powtórzony zbiór slotów " + string(tok[1]));
+            slotSetIds.get(tok[1]);
+            vector<char> in_(in.slots.size(), 0);
+            for (int i = 2; i < n; ++i) {
+                string_view e = tok[i];
+                size_t colon = e.find(':');
+                int d, q;
+                if (e == "*") {
+                    fill(in_.begin(), in_.end(), 1);
+                } else if (colon == string_view::npos) {
+                    if (!parseInt(e, q) || q < 0 || q >= (int)in.slots.size()) return fail("zły slot " + string(e));
+                    in_[q] = 1;
+                } else {
+                    if (!parseInt(e.substr(0, colon), d) || d < 0 || d >= days) return fail("zły dzień w " + string(e));
+                    string_view rest = e.substr(colon + 1);
+                    if (rest == "*") {
+                        for (q = 0; q < periods; ++q) in_[d * periods + q] = 1;
+                    } else {
+                        if (!parseInt(rest, q) || q < 0 || q >= periods) return fail("zła lekcja w " + string(e));
+                        in_[d * periods + q] = 1;
+                    }
+                }
+            }
+            vector<int> set;
+            for (int s = 0; s < (int)in_.size(); ++s) if (in_[s]) set.push_back(s);
+            slotSets.push_back(in.domains.slots.add(move(set)));
+        } else if (cmd == "rooms") {
+            if (n < 3) return fail("oczekiwano rooms ZBIÓR SALA...");
+            if (roomSetIds.find(tok[1]) >= 0) return fail("powtórzony zbiór sal " + string(tok[1]));
+            roomSetIds.get(tok[1]);
+            vector<int> set;
+            for (int i = 2; i < n; ++i) {
+                int r = roomIds.find(tok[i]);
+                if (r < 0) return fail("nieznana sala " + string(tok[i]));
+                set.push_back(r);
+            }
+            roomSets.push_back(in.domains.rooms.add(move(set)));
+        } else if (cmd == "lesson") {
+            Pending L;
+            if ((n != 7 && n != 8) || !parseInt(tok[4], L.hours) || L.hours < 0 ||
+                (n == 8 && (!parseInt(tok[7], L.block) || L.block < 1)))
+                return fail("oczekiwano lesson GRUPA NAUCZYCIEL PRZEDMIOT GODZINY ZBIÓR_SLOTÓW ZBIÓR_SAL [BLOK]");
+            L.group = groupIds.get(tok[1]);
+            L.teacher = teacherIds.get(tok[2]);
+            L.subject = subjectIds.get(tok[3]);
+            L.slotSet = slotSetIds.find(tok[5]);
+            L.roomSet = roomSetIds.find(tok[6]);
+            if (L.slotSet < 0) return fail("nieznany zbiór slotów " + string(tok[5]));
+            if (L.roomSet < 0) return fail("nieznany zbiór sal " + string(tok[6]));
+            pending.push_back(L);
+        } else {
+            return fail("nieznana dyrektywa " + string(cmd));
+        }
+    }
+    if (!slotsReady()) return fail("brak days/periods");
+
+    collides.resize(in.groupName.size());
+    vector<int> collSet(collides.size());
+    for (int g = 0; g < (int)collides.size(); ++g) collSet[g] = in.domains.groups.add(move(collides[g]));
+    in.lessons.reserve(pending.size());
+    for (const Pending& L : pending) {
+        in.lessons.push_back({ (int)in.lessons.size(), L.group, collSet[L.group], L.teacher, L.subject, L.hours,
+                               slotSets[L.slotSet], roomSets[L.roomSet], L.block });
+    }
+    return true;
+}
+
+constexpr char MAGIC[4] = {'S', 'C', 'H', 'B'};
+constexpr int32_t VERSION = 2;
+
+// Czytnik kolejnych int32 i nazw z bufora binarnego; ok == false po wyjściu poza bufor.
+struct Reader {
+    const char* p;
+    const char* end;
+    bool ok = true;
+
+    int32_t i32() {
+        if (end - p < 4) { ok = false; return 0; }
+        int32_t v;
+        memcpy(&v, p, 4);
+        p += 4;
+        return v;
+    }
+    const int32_t* array(size_t n) {
+        if ((size_t)(end - p) < n * 4) { ok = false; return nullptr; }
+        const int32_t* a = (const int32_t*)p;
+        p += n * 4;
+        return a;
+    }
+    // Nazwa: długość, bajty, dopełnienie do 4.
+    string str() {
+        int32_t len = i32();
+        size_t padded = ((size_t)max(len, 0) + 3) & ~size_t(3);
+        if (!ok || len < 0 || (size_t)(end - p) < padded) { ok = false; return {}; }
+        string s(p, len);
+        p += padded;
+        return s;
+    }
+};
+
+inline bool loadBinary(const char* buf, size_t size, Instance& in, ostream& os) {
+    in = Instance();
+    Reader rd{ buf + 4, buf + size };
+    auto fail = [&](const string& why) {
+        os << "[ERR] plik binarny: " << why << "\n";
+        return false;
+    };
+    int version = rd.i32();
+    if (version < 1 || version > VERSION) return fail("nieobsługiwana wersja");
+    int nSlots = rd.i32(), nRooms = rd.i32(), nGroups = rd.i32(), nTeachers = rd.i32(), nSubjects = rd.i32();
+    int nSlotSets = rd.i32(), nRoomSets = rd.i32(), nGroupSets = rd.i32(), nLessons = rd.i32();
+    if (!rd.ok || min({ nSlots, nRooms, nGroups, nTeachers, nSubjects, nSlotSets, nRoomSets, nGroupSets, nLessons }) < 0)
+        return fail("uszkodzony nagłówek");
+
+    const int32_t* sl = rd.array(2 * (size_t)nSlots);
+    for (int s = 0; s < nSlots && rd.ok; ++s) in.slots.push_back({ s, sl[2 * s], sl[2 * s + 1] });
+    for (int r = 0; r < nRooms && rd.ok; ++r) {
+        int cap = rd.i32();
+        in.rooms.push_back({ r, cap, rd.str() });
+    }
+    in.groupName.reserve(nGroups);
+    for (int i = 0; i < nGroups && rd.ok; ++i) in.groupName.push_back(rd.str());
+    in.teacherName.reserve(nTeachers);
+    for (int i = 0; i < nTeachers && rd.ok; ++i) in.teacherName.push_back(rd.str());
+    in.subjectName.reserve(nSubjects);
+    for (int i = 0; i < nSubjects && rd.ok; ++i) in.subjectName.push_back(rd.str());
+    if (!rd.ok) return fail("ucięty plik");
+
+    // Pule domen jako listy CSR: n + 1 przesunięć, potem dane; każdy element musi być < limit.
+    // Zapisane pule są już bez powtórzeń, więc numery list w pliku i w pamięci się pokrywają.
+    auto csr = [&](int n, int limit, DomainPool& out) {
+        const int32_t* off = rd.array(n + 1);
+        if (!rd.ok || off[0] != 0) return false;
+        const int32_t* data = rd.array(off[n]);
+        if (!rd.ok) return false;
+        for (int i = 0; i < n; ++i) {
+            if (off[i + 1] < off[i] || off[i + 1] > off[n]) return false;
+            for (int k = off[i]; k < off[i + 1]; ++k) if (data[k] < 0 || data[k] >= limit) return false;
+            if (out.add(vector<int>(data + off[i], data + off[i + 1])) != i) return false;
+        }
+        return true;
+    };
+    if (!csr(nSlotSets, nSlots, in.domains.slots) || !csr(nRoomSets, nRooms, in.domains.rooms) ||
+        !csr(nGroupSets, nGroups, in.domains.groups))
+        return fail("uszkodzone listy");
+
+    const int fields = version >= 2 ? 8 : 7;
+    const int32_t* ls = rd.array(fields * (size_t)nLessons);
+    if (!rd.ok) return fail("ucięty plik");
+    in.lessons.reserve(nLessons);
+    for (int l = 0; l < nLessons; ++l) {
+        const int32_t* L = ls + fields * l;
+        int block = fields == 8 ? L[7] : 1;
+        if (L[0] < 0 || L[0] >= nGroups || L[1] < 0 || L[1] >= nGroupSets || L[2] < 0 || L[2] >= nTeachers ||
+            L[3] < 0 || L[3] >= nSubjects || L[4] < 0 || L[5] < 0 || L[5] >= nSlotSets || L[6] < 0 || L[6] >= nRoomSets ||
+            block < 1)
+            return fail("uszkodzona lekcja " + to_string(l));
+        in.lessons.push_back({ l, L[0], L[1], L[2], L[3], L[4], L[5], L[6], block });
+    }
+    return true;
+}
+
+// Kolizje są w formacie tekstowym własnością grupy - bierzemy listę z pierwszej lekcji grupy.
+inline vector<int> groupCollisions(const Instance& in) {
+    vector<int> out(in.groupName.size(), -1);
+    for (const Lesson& L : in.lessons) {
+        if (out[L.group] < 0) out[L.group] = L.colidingGroups;
+    }
+    return out;
+}
+
+} // namespace loader
+
+// Wczytuje instancję z pliku tekstowego lub binarnego (rozpoznawanego po nagłówku "SCHB").
+// Przy błędzie wypisuje [ERR] do os i zwraca false.
+inline bool loadInstance(const string& path, Instance& in, ostream& os = cerr) {
+    loader::MappedFile f;
+    if (!f.open(path)) {
+        os << "[ERR] nie można otworzyć " << path << "\n";
+        return false;
+    }
+    if (f.size >= 4 && memcmp(f.data, loader::MAGIC, 4) == 0) return loader::loadBinary(f.data, f.size, in, os);
+    return loader::loadText(f.data, f.size, in, os);
+}
+
+// Zapisuje instancję w formacie tekstowym. Sloty muszą tworzyć siatkę dzień-major.
+inline void saveText(const Instance& in, ostream& out) {
+    auto q = [](const string& s) { return s.find_first_of(" \t#") == string::npos && !s.empty() ? s : "\"" + s + "\""; };
+    int days = 0, periods = 0;
+    for (const Slot& s : in.slots) days = max(days, s.day + 1), periods = max(periods, s.period + 1);
+    vector<int> collides = loader::groupCollisions(in);
+
+    out << "days " << days << "\nperiods " << periods << "\n";
+    for (const Room& r : in.rooms) out << "room " << q(r.roomName) << " " << r.capacity << "\n";
+    for (const string& g : in.groupName) out << "group " << q(g) << "\n";
+    for (const string& t : in.teacherName) out << "teacher " << q(t) << "\n";
+    for (int g = 0; g < (int)collides.size(); ++g) {
+        if (collides[g] < 0 || in.domains.groups[collides[g]].empty()) continue;
+        out << "collides " << q(in.groupName[g]);
+        for (int c : in.domains.groups[collides[g]]) out << " " << q(in.groupName[c]);
+        out << "\n";
+    }
+    for (int i = 0; i < in.domains.slots.size(); ++i) {
+        const vector<int>& set = in.domains.slots[i];
+        if (set.empty()) continue;
+        out << "slots S" << i;
+        if ((int)set.size() == (int)in.slots.size()) out << " *";
+        else for (int s : set) out << " " << in.slots[s].day << ":" << in.slots[s].period;
+        out << "\n";
+    }
+    for (int i = 0; i < in.domains.rooms.size(); ++i) {
+        if (in.domains.rooms[i].empty()) continue;
+        out << "rooms R" << i;
+        for (int r : in.domains.rooms[i]) out << " " << q(in.rooms[r].roomName);
+        out << "\n";
+    }
+    for (int l = 0; l < (int)in.lessons.size(); ++l) {
+        const Lesson& L = in.lessons[l];
+        out << "lesson " << q(in.groupName[L.group]) << " " << q(in.teacherName[L.teacher]) << " "
+            << q(in.subjectName[L.subject]) << " " << L.hours << " S" << L.possibleSlots << " R" << L.possibleRooms;
+        if (L.block > 1) out << " " << L.block;
+        out << "\n";
+    }
+}
+
+// Zapisuje instancję w formacie binarnym (zob. opis na początku pliku).
+inline bool saveBinary(const Instance& in, const string& path, ostream& os = cerr) {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        os << "[ERR] nie można zapisać " << path << "\n";
+        return false;
+    }
+    auto i32 = [&](int32_t v) { out.write((const char*)&v, 4); };
+    auto str = [&](const string& s) {
+        i32((int32_t)s.size());
+        out.write(s.data(), s.size());
+        static const char zero[4] = {};
+        out.write(zero, (4 - s.size() % 4) % 4);
+    };
+    auto csr = [&](const DomainPool& pool) {
+        int32_t off = 0;
+        i32(off);
+        for (auto& l : pool.sets) i32(off += (int32_t)l.size());
+        for (auto& l : pool.sets) for (int x : l) i32(x);
+    };
+
+    out.write(loader::MAGIC, 4);
+    i32(loader::VERSION);
+    for (size_t n : { in.slots.size(), in.rooms.size(), in.groupName.size(), in.teacherName.size(),
+                      in.subjectName.size(), in.domains.slots.sets.size(), in.domains.rooms.sets.size(),
+                      in.domains.groups.sets.size(), in.lessons.size() })
+        i32((int32_t)n);
+    for (const Slot& s : in.slots) i32(s.day), i32(s.period);
+    for (const Room& r : in.rooms) i32(r.capacity), str(r.roomName);
+    for (const string& s : in.groupName) str(s);
+    for (const string& s : in.teacherName) str(s);
+    for (const string& s : in.subjectName) str(s);
+    csr(in.domains.slots);
+    csr(in.domains.rooms);
+    csr(in.domains.groups);
+    for (const Lesson& L : in.lessons) {
+        for (int v : { L.group, L.colidingGroups, L.teacher, L.subject, L.hours, L.possibleSlots, L.possibleRooms, L.block }) i32(v);
+    }
+    return (bool)out;
+}
+
+#endif
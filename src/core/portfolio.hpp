@@ -0,0 +1,81 @@
+#ifndef PORTFOLIO_HPP_
+#define PORTFOLIO_HPP_
+
+#include "solver.hpp"
+
+struct PortfolioParams {
+    int workers = max(1u, thread::hardware_concurrency());
+    int maxIters = 1200000; // budżet sa() każdego uczestnika
+    uint32_t seed = 12345;
+};
+
+// Konfiguracja jednego uczestnika portfela: własny seed, harmonogram i mieszanka ruchów.
+struct PortfolioEntry {
+    uint32_t seed;
+    double T0, alpha;
+    MoveMix moves;
+};
+
+// Rozkłada uczestników po siatce harmonogramów i mieszanek ruchów; pierwszy to ustawienia domyślne main().
+// Mieszanka każdego uczestnika to `base` (np. solver.moves) ze zmienionymi tylko room i freeRoom,
+// więc matchRooms i ustawienia łańcuchów Kempego przechodzą bez zmian.
+inline vector<PortfolioEntry> portfolioEntries(const PortfolioParams& p, const MoveMix& base = {}) {
+    static const double T0s[] = {2.5, 1.0, 5.0, 0.5};
+    static const double alphas[] = {0.99995, 0.9999, 0.99998};
+    static const double roomRates[] = {0.3, 0.15, 0.5};
+    vector<PortfolioEntry> out;
+    for (int i = 0; i < p.workers; ++i) {
+        PortfolioEntry e;
+        seed_seq sq{p.seed, (uint32_t)i};
+        sq.generate(&e.seed, &e.seed + 1);
+        e.T0 = T0s[i % 4];
+        e.alpha = alphas[i % 3];
+        e.moves = base;
+        e.moves.room = roomRates[(i / 4) % 3];
+        e.moves.freeRoom = i % 2 == 1;
+        out.push_back(e);
+    }
+    return out;
+}
+
+// Uruchamia niezależne solvery (każdy z własnym buildInitial() i sa()) na osobnych wątkach.
+// Najlepszy koszt jest współdzielony przez SharedProgress; gdy ktokolwiek osiągnie 0,
+// pozostali kończą przy najbliższym sprawdzeniu cancelled(). Jeśli solver ma już własny
+// SharedProgress (np. z GUI), uczestnicy używają go, więc przerwanie z zewnątrz zatrzymuje
+// cały portfel. Najlepszy plan trafia do solvera.
+// Zwraca indeks uczestnika, którego plan wybrano.
+inline int portfolioSolve(Solver& solver, const PortfolioParams& p) {
+    vector<PortfolioEntry> entries = portfolioEntries(p, solver.moves);
+    SharedProgress local;
+    SharedProgress* progress = solver.shared ? solver.shared : &local;
+
+    vector<Solver> runs;
+    runs.reserve(entries.size());
+    for (const PortfolioEntry& e : entries) {
+        runs.push_back(solver);
+        runs.back().rng.seed(e.seed);
+        runs.back().moves = e.moves;
+        runs.back().shared = progress;
+    }
+
+    vector<thread> pool;
+    for (int i = 0; i < (int)runs.size(); ++i) {
+        pool.emplace_back([&, i] {
+            runs[i].buildInitial();
+            runs[i].sa(p.maxIters, entries[i].T0, entries[i].alpha);
+        });
+    }
+    for (auto& t : pool) t.join();
+
+    int best = 0;
+    for (int i = 1; i < (int)runs.size(); ++i) {
+        if (runs[i].bestCost < runs[best].bestCost) best = i;
+    }
+    solver.bestAssign = runs[best].bestAssign;
+    solver.bestAssignRooms = runs[best].bestAssignRooms;
+    solver.restoreBest();
+    solver.bestCost = solver.curCost;
+    return best;
+}
+
+#endif
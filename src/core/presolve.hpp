@@ -0,0 +1,169 @@
+#ifndef PRESOLVE_HPP_
+#define PRESOLVE_HPP_
+
+#include "solver.hpp"
+
+// Presolve przed buildInitial(): zawęża domeny slotów przez propagację wymuszonych slotów
+// i sprawdza warunki szufladkowe (godziny lekcji, obciążenie nauczycieli i grup, popyt na typy sal).
+// Zawężone domeny trafiają do solvera przez setSlotDomain().
+// Zwraca false, gdy instancja jest na pewno niewykonalna; powód trafia do os.
+inline bool presolve(Solver& S, ostream& os = cerr) {
+    const int numLessons = S.lessons.size();
+    const int SW = S.slotBits.cols;
+    // Robocze kopie bitsetów slotów - propagacja zawęża je osobno dla każdej lekcji.
+    Table<uint64_t> slotBits;
+    slotBits.assign(numLessons, SW, 0);
+    for (int l = 0; l < numLessons; ++l) copy(S.slotRow(l), S.slotRow(l) + SW, slotBits[l]);
+    auto fail = [&](const string& why) {
+        os << "[INFEASIBLE] " << why << "\n";
+        return false;
+    };
+    auto domSize = [&](int l) {
+        int c = 0;
+        for (int w = 0; w < SW; ++w) c += __builtin_popcountll(slotBits[l][w]);
+        return c;
+    };
+    auto lessonName = [&](int l) {
+        return "lekcja " + to_string(S.lessons[l].id) + " (G" + to_string(S.lessons[l].group) + " T" +
+               to_string(S.lessons[l].teacher) + ")";
+    };
+
+    for (int l = 0; l < numLessons; ++l) {
+        const Lesson& L = S.lessons[l];
+        if (L.hours == 0) continue;
+        if (S.slotDomain(l).empty()) return fail(lessonName(l) + " nie ma dozwolonych slotów");
+        if (S.roomDomain(l).empty()) return fail(lessonName(l) + " nie ma dozwolonych sal");
+        if (L.hours > (int)S.slotDomain(l).size())
+            return fail(lessonName(l) + " ma " + to_string(L.hours) + " godz., a tylko " +
+                        to_string(S.slotDomain(l).size()) + " dozwolonych slotów");
+    }
+
+    // Indeksy do szukania lekcji, które nie mogą dzielić slotu z daną lekcją.
+    vector<vector<int>> byTeacher(S.numTeachers), byGroup(S.numGroups), byCollGroup(S.numGroups), bySoleRoom(S.numRooms);
+    for (int l = 0; l < numLessons; ++l) {
+        const Lesson& L = S.lessons[l];
+        if (L.hours == 0) continue;
+        byTeacher[L.teacher].push_back(l);
+        byGroup[L.group].push_back(l);
+        for (int g : S.collDomain(l)) byCollGroup[g].push_back(l);
+        if (S.roomDomain(l).size() == 1) bySoleRoom[S.roomDomain(l)[0]].push_back(l);
+    }
+    auto forEachClash = [&](int l, auto&& f) {
+        const Lesson& L = S.lessons[l];
+        for (int m : byTeacher[L.teacher]) f(m);
+        for (int m : byGroup[L.group]) f(m);
+        for (int m : byCollGroup[L.group]) f(m);
+        for (int g : S.collDomain(l)) for (int m : byGroup[g]) f(m);
+        if (S.roomDomain(l).size() == 1) for (int m : bySoleRoom[S.roomDomain(l)[0]]) f(m);
+    };
+
+    // Lekcja o tylu dozwolonych slotach, ile ma godzin, zajmuje je wszystkie - usuwamy je
+    // z domen lekcji z nią kolidujących. Powtarzamy do punktu stałego.
+    vector<int> size(numLessons), work;
+    vector<char> forced(numLessons, 0), changed(numLessons, 0);
+    for (int l = 0; l < numLessons; ++l) {
+        size[l] = domSize(l);
+        if (S.lessons[l].hours > 0 && size[l] == S.lessons[l].hours) {
+            forced[l] = 1;
+            work.push_back(l);
+        }
+    }
+    int removed = 0;
+    string conflict;
+    while (!work.empty() && conflict.empty()) {
+        int l = work.back();
+        work.pop_back();
+        forEachClash(l, [&](int m) {
+            if (m == l || !conflict.empty()) return;
+            for (int w = 0; w < SW; ++w) slotBits[m][w] &= ~slotBits[l][w];
+            int now = domSize(m);
+            if (now == size[m]) return;
+            removed += size[m] - now;
+            size[m] = now;
+            changed[m] = 1;
+            if (now < S.lessons[m].hours) {
+                conflict = lessonName(m) + " traci sloty na rzecz " + lessonName(l) + " i zostaje z " +
+                           to_string(now) + " na " + to_string(S.lessons[m].hours) + " godz.";
+            } else if (now == S.lessons[m].hours && !forced[m]) {
+                forced[m] = 1;
+                work.push_back(m);
+            }
+        });
+    }
+    if (!conflict.empty()) return fail(conflict);
+
+    vector<uint64_t> uni(SW);
+    auto unionSize = [&](const vector<int>& ls) {
+        fill(uni.begin(), uni.end(), 0);
+        for (int l : ls) for (int w = 0; w < SW; ++w) uni[w] |= slotBits[l][w];
+        int c = 0;
+        for (uint64_t x : uni) c += __builtin_popcountll(x);
+        return c;
+    };
+    auto hoursOf = [&](const vector<int>& ls) {
+        int h = 0;
+        for (int l : ls) h += S.lessons[l].hours;
+        return h;
+    };
+
+    for (int t = 0; t < S.numTeachers; ++t) {
+        int h = hoursOf(byTeacher[t]), avail = unionSize(byTeacher[t]);
+        if (h > avail)
+            return fail("nauczyciel T" + to_string(t) + " ma " + to_string(h) + " godz., a tylko " +
+                        to_string(avail) + " slotów");
+    }
+
+    // Lekcje grupy wykluczają się wzajemnie i z lekcjami grup kolidujących, a te ostatnie mogą
+    // iść równolegle między sobą - potrzeba więc co najmniej godzin(g) + max godzin(c) slotów.
+    vector<vector<int>> collOf(S.numGroups);
+    for (int l = 0; l < numLessons; ++l) {
+        for (int g : S.collDomain(l)) collOf[S.lessons[l].group].push_back(g);
+    }
+    for (int g = 0; g < S.numGroups; ++g) {
+        if (byGroup[g].empty()) continue;
+        sort(collOf[g].begin(), collOf[g].end());
+        collOf[g].erase(unique(collOf[g].begin(), collOf[g].end()), collOf[g].end());
+        int own = hoursOf(byGroup[g]), most = 0, with = -1;
+        vector<int> all = byGroup[g];
+        for (int c : collOf[g]) {
+            int h = hoursOf(byGroup[c]);
+            if (h > most) most = h, with = c;
+            all.insert(all.end(), byGroup[c].begin(), byGroup[c].end());
+        }
+        int avail = unionSize(all);
+        if (own + most > avail)
+            return fail("grupa G" + to_string(g) + " ma " + to_string(own) + " godz." +
+                        (with >= 0 ? " + " + to_string(most) + " godz. kolidującej G" + to_string(with) : "") +
+                        ", a tylko " + to_string(avail) + " slotów");
+    }
+
+    // Popyt lekcji, których sale zawierają się w zbiorze D, musi zmieścić się w |D| * dostępne sloty.
+    const int RW = S.roomBits.cols;
+    map<int, vector<int>> roomSets;
+    for (int l = 0; l < numLessons; ++l) {
+        if (S.lessons[l].hours > 0) roomSets[S.roomSetOf[l]].push_back(l);
+    }
+    for (auto& entry : roomSets) {
+        int D = entry.first;
+        vector<int> inside;
+        for (auto& [E, ls] : roomSets) {
+            if (!bits::anyAndNot(S.roomBits[E], S.roomBits[D], {0, RW})) inside.insert(inside.end(), ls.begin(), ls.end());
+        }
+        int rooms = S.dom.rooms[D].size();
+        long long demand = hoursOf(inside), capacity = (long long)rooms * unionSize(inside);
+        if (demand > capacity)
+            return fail("sale " + S.rooms[S.dom.rooms[D][0]].roomName + "... (" + to_string(rooms) +
+                        ") mają " + to_string(capacity) + " miejsc na " + to_string(demand) + " godz.");
+    }
+
+    for (int l = 0; l < numLessons; ++l) {
+        if (!changed[l]) continue;
+        vector<int> dom;
+        for (int s = 0; s < S.numSlots; ++s) if (bits::test(slotBits[l], s)) dom.push_back(s);
+        S.setSlotDomain(l, move(dom));
+    }
+    os << "[PRESOLVE] usunięto " << removed << " wartości z domen slotów\n";
+    return true;
+}
+
+#endif
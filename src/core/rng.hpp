@@ -0,0 +1,97 @@
+#ifndef RNG_HPP_
+#define RNG_HPP_
+
+#include <bits/stdc++.h>
+using namespace std;
+
+/// ====== GENERATOR LOSOWY SOLVERA ======
+//
+// xoshiro256** (Blackman, Vigna): 256 bitów stanu, ~1 ns na 64-bitowe słowo. Spełnia wymagania
+// UniformRandomBitGenerator, więc działa z shuffle() i rozkładami z <random>, ale gorące pętle
+// losują przez below()/uniform(). below(n) to bezstronne losowanie z [0, n) metodą Lemire'a
+// (mnożenie 32x32 -> 64 zamiast dzielenia, odrzucenie tylko przy rzadkim przekroczeniu progu);
+// jedno 64-bitowe słowo daje dwie takie wartości - druga połowa czeka w `spare`.
+// Stan (z połówką w zapasie) zapisuje i wczytuje operator<< / operator>>.
+struct Xoshiro256ss {
+    using result_type = uint64_t;
+    uint64_t s[4];
+    uint64_t spare = 0;
+    bool hasSpare = false;
+
+    explicit Xoshiro256ss(uint64_t seed = 0x9E3779B97F4A7C15ull) { this->seed(seed); }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return ~uint64_t(0); }
+
+    // Stan z splitmix64 - różne seedy dają niezależnie wyglądające strumienie, także 0.
+    void seed(uint64_t x) {
+        for (uint64_t& w : s) {
+            uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            w = z ^ (z >> 31);
+        }
+        hasSpare = false;
+    }
+    template <class Seq, class = decltype(declval<Seq&>().generate((uint32_t*)nullptr, (uint32_t*)nullptr))>
+    void seed(Seq& seq) {
+        uint32_t w[8];
+        seq.generate(w, w + 8);
+        for (int i = 0; i < 4; ++i) s[i] = (uint64_t)w[2 * i] << 32 | w[2 * i + 1];
+        if (!(s[0] | s[1] | s[2] | s[3])) s[0] = 1;
+        hasSpare = false;
+    }
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t operator()() {
+        uint64_t r = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return r;
+    }
+
+    uint32_t next32() {
+        if (hasSpare) {
+            hasSpare = false;
+            return (uint32_t)spare;
+        }
+        spare = (*this)();
+        hasSpare = true;
+        return (uint32_t)(spare >> 32);
+    }
+
+    // Bezstronnie z [0, n), n >= 1.
+    uint32_t below(uint32_t n) {
+        uint64_t m = (uint64_t)next32() * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n) {
+            uint32_t threshold = -n % n;
+            while (low < threshold) {
+                m = (uint64_t)next32() * n;
+                low = (uint32_t)m;
+            }
+        }
+        return m >> 32;
+    }
+
+    // Z [0, 1) z 53 bitów.
+    double uniform() { return ((*this)() >> 11) * 0x1p-53; }
+
+    friend ostream& operator<<(ostream& os, const Xoshiro256ss& g) {
+        return os << g.s[0] << ' ' << g.s[1] << ' ' << g.s[2] << ' ' << g.s[3] << ' ' << g.hasSpare << ' ' << g.spare;
+    }
+    friend istream& operator>>(istream& is, Xoshiro256ss& g) {
+        return is >> g.s[0] >> g.s[1] >> g.s[2] >> g.s[3] >> g.hasSpare >> g.spare;
+    }
+};
+
+// Generator używany przez Solver; inny musi mieć ten sam interfejs (seed, below, uniform, <<, >>).
+using SolverRng = Xoshiro256ss;
+
+#endif
@@ -0,0 +1,1622 @@
+#ifndef SOLVER_HPP_
+#define SOLVER_HPP_
+
+#include "bitset.hpp"
+#include "rng.hpp"
+#include "telemetry.hpp"
+
+struct Slot { int id, day, period; };
+struct Room { int roomId, capacity; string roomName; };
+
+// Pula internowanych list indeksów: każda różna lista (posortowana, bez powtórzeń)
+// jest trzymana raz, a lekcje wskazują ją numerem.
+struct DomainPool {
+    vector<vector<int>> sets;
+    map<vector<int>, int> index;
+
+    int add(vector<int> s) {
+        sort(s.begin(), s.end());
+        s.erase(unique(s.begin(), s.end()), s.end());
+        auto it = index.emplace(s, (int)sets.size());
+        if (it.second) sets.push_back(move(s));
+        return it.first->second;
+    }
+    const vector<int>& operator[](int i) const { return sets[i]; }
+    int size() const { return sets.size(); }
+};
+
+// Wspólne domeny instancji: listy slotów, sal i kolidujących grup.
+struct Domains {
+    DomainPool slots, rooms, groups;
+};
+
+struct Lesson {
+    int id;
+    int group;
+    int colidingGroups; // indeks w Domains::groups
+    int teacher;
+    int subject; // indeks nazwy przedmiotu w Instance::subjectName
+    int hours;
+    int possibleSlots;  // indeks w Domains::slots
+    int possibleRooms;  // indeks w Domains::rooms
+    int block = 1;      // godziny idą blokami po tyle kolejnych lekcji jednego dnia (ostatni może być krótszy)
+};
+
+struct Variable { int id, lessonIdx, idx; };
+
+// Udziały typów ruchów w step(); reszta przenosi lekcję do nowego slotu i sali. Z matchRooms ruchu
+// samej sali nie ma, więc jego udział dostaje przeniesienie: domyślnie 0.85 / 0.1 / 0.05
+// (przeniesienie / wymiana / Kempe) zamiast 0.55 / 0.3 / 0.1 / 0.05.
+struct MoveMix {
+    double room = 0.3;   // tylko zmiana sali
+    double swap = 0.1;   // wymiana slotów i sal dwóch lekcji
+    double kempe = 0.05; // łańcuch Kempego między dwoma slotami
+    bool kempeRooms = false; // czy wspólna sala też łączy lekcje w łańcuch
+    int maxChain = 64;
+    bool freeRoom = false; // przenosząc lekcję, wybieraj wolną salę w nowym slocie, jeśli jest
+    bool matchRooms = false; // SA przesuwa tylko sloty, sale przydziela skojarzenie w slocie
+};
+
+// Harmonogram saAdaptive(). Zamiast stałego T *= alpha temperatura jest sterowana tak, by odsetek
+// przyjętych pogorszeń w oknie szedł za celem malejącym geometrycznie od acceptStart do acceptEnd
+// w ciągu epochIters iteracji. Po reheatAfter iteracjach bez nowego najlepszego zaczyna się nowa
+// epoka od acceptReheat (T kalibrowane na nowo z bieżącego planu).
+struct Cooling {
+    int maxIters = 1200000;
+    double maxSeconds = 0;       // limit czasu; 0 - bez limitu
+    int stallIters = 500000;     // stop po tylu iteracjach bez nowego najlepszego; 0 - bez limitu
+    double acceptStart = 0.05, acceptEnd = 1e-6, acceptReheat = 0.003;
+    int epochIters = 300000;
+    int reheatAfter = 200000;    // 0 - bez podgrzewania
+    int window = 1000;           // co ile iteracji korygować T
+    int samples = 500;           // próbne ruchy przy kalibracji T
+};
+
+// Wagi ograniczeń miękkich (0 - wyłączone), liczone po (nauczyciel | grupa, dzień) i (lekcja, dzień):
+//   gap    - okienka: puste lekcje między pierwszą a ostatnią zajętą w dniu
+//   load   - kwadrat liczby zajętych lekcji w dniu; suma jest najmniejsza przy równym rozłożeniu
+//   spread - pary godzin tej samej lekcji w jednym dniu
+// Grupy liczone są osobno - okienka klasy nie widzą lekcji jej podgrup.
+struct SoftWeights {
+    int gap = 0, load = 0, spread = 0;
+    bool any() const { return gap > 0 || load > 0 || spread > 0; }
+};
+
+// Stan współdzielony przez solvery działające równolegle na tej samej instancji. Podproblem
+// (np. składowa w dekompozycji) ma własny stan z parent: widzi przerwanie rodzica, ale swojego
+// kosztu ani zatrzymania przy 0 do rodzica nie przekazuje.
+struct SharedProgress {
+    atomic<int> bestCost{INT_MAX};
+    atomic<bool> stop{false};
+    const SharedProgress* parent = nullptr;
+
+    bool stopped() const { return stop.load(memory_order_relaxed) || (parent && parent->stopped()); }
+
+    void publish(int cost) {
+        int cur = bestCost.load(memory_order_relaxed);
+        while (cost < cur && !bestCost.compare_exchange_weak(cur, cost, memory_order_relaxed)) {}
+        if (cost == 0) stop.store(true, memory_order_relaxed);
+    }
+};
+
+// Płaska tablica wiersz-po-wierszu, indeksowana jak vector<vector<T>>: t[wiersz][kolumna].
+template <class T> struct Table {
+    int rows = 0, cols = 0;
+    vector<T> data;
+
+    void assign(int rows_, int cols_, T val) {
+        rows = rows_;
+        cols = cols_;
+        data.assign((size_t)rows * cols, val);
+    }
+    void appendRow(T val) {
+        data.resize((size_t)++rows * cols, val);
+    }
+    T* operator[](int r) { return data.data() + (size_t)r * cols; }
+    const T* operator[](int r) const { return data.data() + (size_t)r * cols; }
+};
+
+// Liczniki zajętości nauczycieli, grup i sal w jednym ciągłym buforze.
+// Układ slot-major: wiersz slotu to [nauczyciele | grupy | sale], więc wszystkie liczniki
+// sprawdzane przy ocenie ruchu w danym slocie leżą obok siebie.
+// Równolegle utrzymywane są bitsety "licznik > 0" w tym samym układzie, po słowach.
+struct Occupancy {
+    using Count = uint16_t;
+
+    int numSlots = 0, numTeachers = 0, numGroups = 0, numRooms = 0, stride = 0;
+    vector<Count> cnt;
+    int teacherWords = 0, groupWords = 0, roomWords = 0, bitStride = 0;
+    vector<uint64_t> bitsBuf;
+
+    void init(int numSlots_, int numTeachers_, int numGroups_, int numRooms_) {
+        numSlots = numSlots_;
+        numTeachers = numTeachers_;
+        numGroups = numGroups_;
+        numRooms = numRooms_;
+        stride = numTeachers + numGroups + numRooms;
+        cnt.assign((size_t)numSlots * stride, 0);
+        teacherWords = bits::words(numTeachers);
+        groupWords = bits::words(numGroups);
+        roomWords = bits::words(numRooms);
+        bitStride = teacherWords + groupWords + roomWords;
+        bitsBuf.assign((size_t)numSlots * bitStride, 0);
+    }
+    void clear() {
+        fill(cnt.begin(), cnt.end(), 0);
+        fill(bitsBuf.begin(), bitsBuf.end(), 0);
+    }
+
+    uint64_t* bitRow(int s) { return bitsBuf.data() + (size_t)s * bitStride; }
+    const uint64_t* teacherBits(int s) const { return bitsBuf.data() + (size_t)s * bitStride; }
+    const uint64_t* groupBits(int s) const { return teacherBits(s) + teacherWords; }
+    const uint64_t* roomBits(int s) const { return groupBits(s) + groupWords; }
+
+    Count* row(int s) { return cnt.data() + (size_t)s * stride; }
+    const Count* row(int s) const { return cnt.data() + (size_t)s * stride; }
+
+    const Count* teachers(int s) const { return row(s); }
+    const Count* groups(int s) const { return row(s) + numTeachers; }
+    const Count* roomsIn(int s) const { return row(s) + numTeachers + numGroups; }
+
+    Count& teacher(int s, int t) { return row(s)[t]; }
+    Count& group(int s, int g) { return row(s)[numTeachers + g]; }
+    Count& room(int s, int r) { return row(s)[numTeachers + numGroups + r]; }
+    Count teacher(int s, int t) const { return row(s)[t]; }
+    Count group(int s, int g) const { return row(s)[numTeachers + g]; }
+    Count room(int s, int r) const { return row(s)[numTeachers + numGroups + r]; }
+
+    void add(int s, int t, int g, int r) {
+        Count* c = row(s);
+        uint64_t* b = bitRow(s);
+        if (c[t]++ == 0) bits::set(b, t);
+        if (c[numTeachers + g]++ == 0) bits::set(b + teacherWords, g);
+        if (c[numTeachers + numGroups + r]++ == 0) bits::set(b + teacherWords + groupWords, r);
+    }
+    void remove(int s, int t, int g, int r) {
+        Count* c = row(s);
+        uint64_t* b = bitRow(s);
+        if (--c[t] == 0) bits::reset(b, t);
+        if (--c[numTeachers + g] == 0) bits::reset(b + teacherWords, g);
+        if (--c[numTeachers + numGroups + r] == 0) bits::reset(b + teacherWords + groupWords, r);
+    }
+
+    // Pojedynczy licznik nauczyciela lub sali (blokady bez lekcji); d to +1 albo -1.
+    void addTeacher(int s, int t, int d) { bump(row(s)[t], bitRow(s), t, d); }
+    void addRoom(int s, int r, int d) { bump(row(s)[numTeachers + numGroups + r], bitRow(s) + teacherWords + groupWords, r, d); }
+    static void bump(Count& c, uint64_t* b, int i, int d) {
+        if (d > 0 && c++ == 0) bits::set(b, i);
+        if (d < 0 && --c == 0) bits::reset(b, i);
+    }
+};
+
+struct Solver {
+    vector<Slot>& allSlots;
+    vector<Lesson>& lessons;
+    vector<Room> rooms;
+
+    vector<Variable> vars;
+
+    // Domeny lekcji to numery list we wspólnych pulach; presolve może przepiąć lekcję
+    // na węższą listę slotów. Bitsety (dozwolone sloty, sale, kolidujące grupy) i przedziały
+    // słów z ustawionymi bitami liczone są raz na listę, nie na lekcję.
+    Domains dom;
+    vector<int> slotSetOf, roomSetOf, collSetOf;
+    Table<uint64_t> slotBits;
+    Table<uint64_t> roomBits;
+    Table<uint64_t> collBits;
+    vector<bits::Span> roomSpan, collSpan;
+    vector<int> slotOf;
+    vector<int> roomOf;
+
+    Occupancy busy;
+    // Blokady nauczycieli i sal w slotach (re-solve): liczniki, od których startuje busy.
+    Occupancy pinned;
+#ifdef SCHEDULER_TELEMETRY
+    // Liczniki ruchów, czasy faz i okna kosztu sa() (telemetry.hpp).
+    Telemetry telemetry;
+#endif
+
+    // Pamięć podręczna kosztów: varCost[v] == varCostRemovedSelf(v, slotOf[v], roomOf[v]),
+    // curCost to ich suma. applyMove() przelicza tylko zmienne z dotkniętych slotów, które
+    // dzielą z przenoszoną lekcją nauczyciela, grupę (także kolidującą) lub salę.
+    vector<int> varCost;
+    int curCost = 0;
+    // Zmienne w każdym slocie; slotPos[v] to pozycja v w slotVars[slotOf[v]].
+    vector<vector<int>> slotVars;
+    vector<int> slotPos;
+    // Zbiór zmiennych z kosztem > 0 z usuwaniem w O(1); conflictPos[v] == -1 poza zbiorem.
+    vector<int> conflicted;
+    vector<int> conflictPos;
+
+    int numSlots, numTeachers, numGroups, numRooms;
+
+    vector<int> bestAssign, bestAssignRooms;
+    int bestCost = INT_MAX;
+    const int W_TEACH = 1;
+    const int W_GROUP = 1;
+    const int W_COLL  = 1;
+    const int W_ROOM  = 1;
+    const int W_DISALLOWED = 1000;
+
+
+    MoveMix moves;
+    // Opcjonalnie: gdzie publikować najlepszy koszt i skąd czytać żądanie przerwania.
+    SharedProgress* shared = nullptr;
+    // Termin (np. z --time-limit), po którym silniki kończą jak po przerwaniu; kopie solvera go dziedziczą.
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::time_point::max();
+
+    SolverRng rng{random_device{}()};
+    bool verify_and_report(ostream& os = cerr) const {
+
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            if (slotOf[v] < 0 || roomOf[v] < 0) {
+                os << "[ERR] v=" << v << " nieprzypisany\n";
+                return false;
+            }
+        }
+        Occupancy check = pinned;
+
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            int s = slotOf[v], r = roomOf[v];
+            const Lesson& L = lessons[vars[v].lessonIdx];
+
+            if (!slotAllowed(v, s)) { os << "[ERR] v="<<v<<" w niedozwolonym slocie "<<s<<"\n"; return false; }
+            if (!roomAllowed(v, r)) { os << "[ERR] v="<<v<<" w niedozwolonej sali "<<r<<"\n"; return false; }
+
+            check.add(s, L.teacher, L.group, r);
+            if (check.teacher(s, L.teacher) > 1) { os << "[ERR] konflikt nauczyciela T"<<L.teacher<<" w slocie "<<s<<"\n"; return false; }
+            if (check.group(s, L.group)     > 1) { os << "[ERR] konflikt grupy G"<<L.group<<" w slocie "<<s<<"\n"; return false; }
+            if (check.room(s, r)            > 1) { os << "[ERR] konflikt sali R"<<r<<" w slocie "<<s<<"\n"; return false; }
+        }
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            int s = slotOf[v], l = vars[v].lessonIdx;
+            if (bits::anyAnd(collRow(l), check.groupBits(s), collSpanOf(l))) {
+                int g = 0;
+                while (!bits::test(collRow(l), g) || !bits::test(check.groupBits(s), g)) g++;
+                os << "[ERR] kolizja kolidujących grup: G"<<lessons[l].group<<" vs G"<<g<<" w slocie "<<s<<"\n";
+                return false;
+            }
+        }
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            if (v != blockFirst[v] || blockIntact(v)) continue;
+            os << "[ERR] rozbity blok lekcji L" << vars[v].lessonIdx << " od slotu " << slotOf[v] << "\n";
+            return false;
+        }
+
+        os << "[OK] Plan spełnia wszystkie twarde ograniczenia.\n";
+        return true;
+    }
+
+    Solver(vector<Slot>& slots, vector<Lesson>& les, vector<Room> rms, const Domains& domains,
+           int numGroups_, int numTeachers_)
+      : allSlots(slots), lessons(les), rooms(move(rms)), dom(domains), numSlots(allSlots.size()), numTeachers(numTeachers_), numGroups(numGroups_) {
+
+        numSlots = allSlots.size();
+        numRooms = rooms.size();
+        int cur = 0;
+        for (int l = 0; l < lessons.size(); ++l) {
+            for (int i = 0; i < lessons[l].hours; ++i) {
+                vars.push_back({cur++, l, i});
+            }
+        }
+
+        for (const Lesson& L : lessons) {
+            slotSetOf.push_back(L.possibleSlots);
+            roomSetOf.push_back(L.possibleRooms);
+            collSetOf.push_back(L.colidingGroups);
+        }
+        slotBits.assign(dom.slots.size(), bits::words(numSlots), 0);
+        roomBits.assign(dom.rooms.size(), bits::words(numRooms), 0);
+        collBits.assign(dom.groups.size(), bits::words(numGroups), 0);
+        for (int i = 0; i < dom.slots.size(); ++i) {
+            for (int s : dom.slots[i]) bits::set(slotBits[i], s);
+        }
+        for (int i = 0; i < dom.rooms.size(); ++i) {
+            for (int r : dom.rooms[i]) bits::set(roomBits[i], r);
+            roomSpan.push_back(bits::span(roomBits[i], roomBits.cols));
+        }
+        for (int i = 0; i < dom.groups.size(); ++i) {
+            for (int g : dom.groups[i]) bits::set(collBits[i], g);
+            collSpan.push_back(bits::span(collBits[i], collBits.cols));
+        }
+
+        busy.init(numSlots, numTeachers, numGroups, numRooms);
+        pinned.init(numSlots, numTeachers, numGroups, numRooms);
+
+        slotOf.assign(vars.size(), -1);
+        roomOf.assign(vars.size(), -1);
+        varCost.assign(vars.size(), 0);
+        slotPos.assign(vars.size(), -1);
+        conflictPos.assign(vars.size(), -1);
+        conflicted.reserve(vars.size());
+        slotVars.resize(numSlots);
+        for (auto& sv : slotVars) sv.reserve(2 * vars.size() / max(1, numSlots) + 16);
+        bestAssign = slotOf;
+        bestAssignRooms = roomOf;
+
+        map<pair<int, int>, int> at;
+        for (const Slot& sl : allSlots) at[{sl.day, sl.period}] = sl.id;
+        nextSlot.assign(numSlots, -1);
+        for (const Slot& sl : allSlots) {
+            auto it = at.find({sl.day, sl.period + 1});
+            if (it != at.end()) nextSlot[sl.id] = it->second;
+        }
+        initBlocks();
+        initRoomClasses();
+    }
+
+    const vector<int>& slotDomain(int l) const { return dom.slots[slotSetOf[l]]; }
+    const vector<int>& roomDomain(int l) const { return dom.rooms[roomSetOf[l]]; }
+    const vector<int>& collDomain(int l) const { return dom.groups[collSetOf[l]]; }
+    const uint64_t* slotRow(int l) const { return slotBits[slotSetOf[l]]; }
+    const uint64_t* roomRow(int l) const { return roomBits[roomSetOf[l]]; }
+    const uint64_t* collRow(int l) const { return collBits[collSetOf[l]]; }
+    bits::Span roomSpanOf(int l) const { return roomSpan[roomSetOf[l]]; }
+    bits::Span collSpanOf(int l) const { return collSpan[collSetOf[l]]; }
+
+    // Przepina lekcję l na listę slotów s (internowaną w dom.slots).
+    void setSlotDomain(int l, vector<int> s) {
+        int before = dom.slots.size();
+        slotSetOf[l] = dom.slots.add(move(s));
+        if (dom.slots.size() == before) return;
+        slotBits.appendRow(0);
+        for (int x : dom.slots[slotSetOf[l]]) bits::set(slotBits[slotSetOf[l]], x);
+    }
+
+    // Przepina lekcję l na listę sal r (internowaną w dom.rooms).
+    void setRoomDomain(int l, vector<int> r) {
+        int before = dom.rooms.size();
+        roomSetOf[l] = dom.rooms.add(move(r));
+        if (dom.rooms.size() == before) return;
+        roomBits.appendRow(0);
+        for (int x : dom.rooms[roomSetOf[l]]) bits::set(roomBits[roomSetOf[l]], x);
+        roomSpan.push_back(bits::span(roomBits[roomSetOf[l]], roomBits.cols));
+        initRoomClasses();
+    }
+
+    // Klasy sal: sale o tej samej pojemności należące do tych samych list w dom.rooms są dla
+    // kosztu nierozróżnialne (np. Gen-0..Gen-9). Ruch do innej sali tej samej klasy w tym samym
+    // slocie niczego nie zmienia, więc step() losuje klasę, a salę bierze wolną z tej klasy;
+    // konkretne numery porządkuje dopiero canonicalize(). classBits[c] to bitset sal klasy c.
+    vector<int> roomClass;
+    Table<uint64_t> classBits;
+    vector<bits::Span> classSpan;
+
+    void initRoomClasses() {
+        vector<vector<int>> member(numRooms);
+        for (int i = 0; i < dom.rooms.size(); ++i) {
+            for (int r : dom.rooms[i]) member[r].push_back(i);
+        }
+        map<pair<int, vector<int>>, int> classOf;
+        roomClass.assign(numRooms, 0);
+        for (int r = 0; r < numRooms; ++r) {
+            roomClass[r] = classOf.emplace(pair(rooms[r].capacity, move(member[r])), (int)classOf.size()).first->second;
+        }
+        classBits.assign(classOf.size(), bits::words(numRooms), 0);
+        for (int r = 0; r < numRooms; ++r) bits::set(classBits[roomClass[r]], r);
+        classSpan.clear();
+        for (int c = 0; c < classBits.rows; ++c) classSpan.push_back(bits::span(classBits[c], classBits.cols));
+    }
+
+    // Najniższa wolna sala z klasy sali r w slocie s; r, gdy wolnej nie ma.
+    int freeInClass(int r, int s) const {
+        int c = roomClass[r];
+        if (bits::popcountAndNot(classBits[c], busy.roomBits(s), classSpan[c]) == 0) return r;
+        return bits::selectAndNot(classBits[c], busy.roomBits(s), classSpan[c], 0);
+    }
+
+    bool slotAllowed(int v, int s) const { return bits::test(slotRow(vars[v].lessonIdx), s); }
+    bool roomAllowed(int v, int r) const { return bits::test(roomRow(vars[v].lessonIdx), r); }
+    bool collides(int l, int s) const { return bits::anyAnd(collRow(l), busy.groupBits(s), collSpanOf(l)); }
+
+    int varCostNoSelf(int v, int s, int r) {
+        const Lesson& L = lessons[vars[v].lessonIdx];
+        const Occupancy::Count* teacherRow = busy.teachers(s);
+        const Occupancy::Count* groupRow = busy.groups(s);
+        const Occupancy::Count* roomRow = busy.roomsIn(s);
+
+        int cost = 0;
+        cost+=!slotAllowed(v, s) ? W_DISALLOWED : 0;
+        cost+=!roomAllowed(v, r) ? W_DISALLOWED : 0;
+        cost+=teacherRow[L.teacher] > 0 ? W_TEACH : 0;
+        cost+=groupRow[L.group] > 0 ? W_GROUP : 0;
+        cost+=roomRow[r] > 0 ? W_ROOM : 0;
+        cost+=collides(vars[v].lessonIdx, s) ? W_COLL : 0;
+
+        return cost;
+    }
+
+    int varCostRemovedSelf(int v, int s, int r) const {
+        const Lesson& L = lessons[vars[v].lessonIdx];
+        const Occupancy::Count* teacherRow = busy.teachers(s);
+        const Occupancy::Count* groupRow = busy.groups(s);
+        const Occupancy::Count* roomRow = busy.roomsIn(s);
+        int cost=0;
+
+        int curTeacherBusy=teacherRow[L.teacher] - (slotOf[v]==s);
+        int curGroupBusy=groupRow[L.group] - (slotOf[v]==s);
+        int curRoomBusy=roomRow[r] - (slotOf[v]==s and roomOf[v]==r);
+
+        cost+=!slotAllowed(v, s) ? W_DISALLOWED : 0;
+        cost+=!roomAllowed(v, r) ? W_DISALLOWED : 0;
+        cost+=curGroupBusy>0 ? W_GROUP : 0;
+        cost+=curTeacherBusy>0 ? W_TEACH : 0;
+        cost+=curRoomBusy>0 ? W_ROOM : 0;
+
+        cost+=collides(vars[v].lessonIdx, s) ? W_COLL : 0;
+        return cost;
+
+    }
+
+
+    void resetBusy() {
+        busy.cnt = pinned.cnt;
+        busy.bitsBuf = pinned.bitsBuf;
+    }
+
+    void buildInitial() {
+        buildFrom(vector<int>(vars.size(), -1), vector<int>(vars.size(), -1));
+    }
+
+    // Start od wcześniejszego planu (np. z poprzedniego tygodnia): zmienne z dozwolonym
+    // slotem i salą w slot/room zostają na miejscu, pozostałe (-1 lub niedozwolone po edycji)
+    // są dokładane zachłannie jak w buildInitial().
+    void buildFrom(const vector<int>& slot, const vector<int>& room) {
+        resetBusy();
+        fill(slotOf.begin(), slotOf.end(), -1);
+        fill(roomOf.begin(), roomOf.end(), -1);
+        // Blok zostaje tylko w całości i w kolejnych slotach; w order trafia jego pierwsza zmienna.
+        vector<int> order;
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            if (v != blockFirst[v]) continue;
+            bool keep = true;
+            for (int x = v; x < v + blockLen[v] && keep; ++x) {
+                keep = slot[x] >= 0 && slot[x] < numSlots && room[x] >= 0 && room[x] < numRooms &&
+                       slotAllowed(x, slot[x]) && roomAllowed(x, room[x]) &&
+                       (x == v || slot[x] == nextSlot[slot[x - 1]]);
+            }
+            if (!keep) { order.push_back(v); continue; }
+            for (int x = v; x < v + blockLen[v]; ++x) {
+                const Lesson& L = lessons[vars[x].lessonIdx];
+                slotOf[x] = slot[x];
+                roomOf[x] = room[x];
+                busy.add(slot[x], L.teacher, L.group, room[x]);
+            }
+        }
+        shuffle(order.begin(), order.end(), rng);
+
+        vector<int> candS;
+        for (int v : order) {
+            if (blockLen[v] > 1) placeBlockGreedy(v, candS);
+            else placeGreedy(v, candS);
+        }
+        rebuild();
+        if (moves.matchRooms) matchAllRooms();
+        syncBest();
+        bestCost = totalCost();
+    }
+
+    // Stawia zmienną v w pierwszym znalezionym slocie bez konfliktu (albo najtańszym) i dopisuje
+    // ją do busy; pamięci kosztów nie aktualizuje - to robi rebuild() po rozmieszczeniu wszystkich.
+    void placeGreedy(int v, vector<int>& candS) {
+        const Lesson& L = lessons[vars[v].lessonIdx];
+        int l = vars[v].lessonIdx;
+        int bestC=INT_MAX;
+        int bestS = rng.below(numSlots);
+        int bestR = rng.below(numRooms);
+
+        candS = slotDomain(l);
+        shuffle(candS.begin(), candS.end(), rng);
+        for (int s : candS) {
+            // W danym slocie koszt zależy od sali tylko przez jej zajętość, więc wystarczy
+            // wylosować wolną dozwoloną salę (dozwolone & ~zajęte), a gdy jej brak - dowolną.
+            int freeRooms = bits::popcountAndNot(roomRow(l), busy.roomBits(s), roomSpanOf(l));
+            int r = freeRooms > 0
+                ? bits::selectAndNot(roomRow(l), busy.roomBits(s), roomSpanOf(l),
+                                     rng.below(freeRooms))
+                : pickRoom(v);
+            int cur=varCostNoSelf(v,s,r);
+            if (cur<bestC) {
+                bestC = cur;
+                bestR = r;
+                bestS = s;
+                if (bestC==0) {
+                    break;
+                }
+            }
+        }
+        slotOf[v]=bestS;
+        roomOf[v]=bestR;
+        busy.add(bestS, L.teacher, L.group, bestR);
+    }
+
+    // Jak placeGreedy() dla całego bloku h: pierwszy start bez konfliktu (albo najtańszy), sale
+    // wolne, jeśli są. Blok, który nie mieści się w żadnym dniu, rozkładany jest jak zwykłe godziny.
+    void placeBlockGreedy(int h, vector<int>& candS) {
+        int n = blockLen[h];
+        int bestC = INT_MAX;
+        vector<int> bestSlots, bestRooms;
+        candS = slotDomain(vars[h].lessonIdx);
+        shuffle(candS.begin(), candS.end(), rng);
+        for (int s : candS) {
+            if (!planBlock(h, s)) continue;
+            int cur = 0;
+            for (int i = 0; i < n; ++i) cur += varCostNoSelf(h + i, blockSlots[i], blockRooms[i]);
+            if (cur < bestC) {
+                bestC = cur;
+                bestSlots = blockSlots;
+                bestRooms = blockRooms;
+                if (bestC == 0) break;
+            }
+        }
+        if (bestSlots.empty()) {
+            for (int x = h; x < h + n; ++x) placeGreedy(x, candS);
+            return;
+        }
+        for (int i = 0; i < n; ++i) {
+            const Lesson& L = lessons[vars[h + i].lessonIdx];
+            slotOf[h + i] = bestSlots[i];
+            roomOf[h + i] = bestRooms[i];
+            busy.add(bestSlots[i], L.teacher, L.group, bestRooms[i]);
+        }
+    }
+
+    int totalCost() const { return curCost; }
+
+    void setCost(int v, int c) {
+        curCost += c - varCost[v];
+        varCost[v] = c;
+        if (c > 0 && conflictPos[v] < 0) {
+            conflictPos[v] = conflicted.size();
+            conflicted.push_back(v);
+        } else if (c == 0 && conflictPos[v] >= 0) {
+            int last = conflicted.back();
+            conflicted[conflictPos[v]] = last;
+            conflictPos[last] = conflictPos[v];
+            conflicted.pop_back();
+            conflictPos[v] = -1;
+        }
+    }
+
+    // Odtwarza liczniki, listy slotów i koszty z bieżącego slotOf/roomOf.
+    void rebuild() {
+        journalFull = true;
+        resetBusy();
+        for (auto& sv : slotVars) sv.clear();
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            const Lesson& L = lessons[vars[v].lessonIdx];
+            busy.add(slotOf[v], L.teacher, L.group, roomOf[v]);
+            slotPos[v] = slotVars[slotOf[v]].size();
+            slotVars[slotOf[v]].push_back(v);
+        }
+        conflicted.clear();
+        fill(conflictPos.begin(), conflictPos.end(), -1);
+        fill(varCost.begin(), varCost.end(), 0);
+        curCost = 0;
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            setCost(v, varCostRemovedSelf(v, slotOf[v], roomOf[v]));
+        }
+        if (softOn) rebuildSoft();
+    }
+
+    // Przelicza koszty zmiennych w slocie s, na które wpływa zmiana liczników
+    // nauczyciela t, grupy g oraz sal r1/r2 w tym slocie.
+    void refreshSlot(int s, int t, int g, int r1, int r2) {
+        for (int u : slotVars[s]) {
+            const Lesson& U = lessons[vars[u].lessonIdx];
+            bool hit = U.teacher == t || U.group == g || roomOf[u] == r1 || roomOf[u] == r2 ||
+                       (g >= 0 && bits::test(collRow(vars[u].lessonIdx), g));
+            if (hit) setCost(u, varCostRemovedSelf(u, s, roomOf[u]));
+        }
+    }
+
+    int deltaMove(int v, int ns, int nr)  {
+        int s0 = slotOf[v], r0 = roomOf[v];
+
+        int before = varCostRemovedSelf(v, s0, r0);
+        int after  = varCostRemovedSelf(v, ns, nr);
+        return after - before;
+    }
+
+    // Przestawia liczniki i przypisanie bez aktualizacji list slotów i kosztów - do ocen na próbę.
+    void rawMove(int v, int ns, int nr) {
+        const Lesson& L = lessons[vars[v].lessonIdx];
+        busy.remove(slotOf[v], L.teacher, L.group, roomOf[v]);
+        busy.add(ns, L.teacher, L.group, nr);
+        if (softOn && ns != slotOf[v]) moveSoftMasks(vars[v].lessonIdx, slotOf[v], ns);
+        slotOf[v] = ns; roomOf[v] = nr;
+    }
+
+    inline void applyMove(int v, int ns, int nr) {
+        int s0 = slotOf[v], r0 = roomOf[v];
+        const Lesson& L = lessons[vars[v].lessonIdx];
+        touch(v);
+        if (softOn) softCost += softMoveDelta(v, ns);
+        rawMove(v, ns, nr);
+        if (ns != s0) {
+            vector<int>& from = slotVars[s0];
+            int last = from.back();
+            from[slotPos[v]] = last;
+            slotPos[last] = slotPos[v];
+            from.pop_back();
+            slotPos[v] = slotVars[ns].size();
+            slotVars[ns].push_back(v);
+            refreshSlot(s0, L.teacher, L.group, r0, -1);
+            refreshSlot(ns, L.teacher, L.group, nr, -1);
+        } else {
+            refreshSlot(ns, -1, -1, r0, nr);
+        }
+        setCost(v, varCostRemovedSelf(v, ns, nr));
+    }
+
+    // Losowanie kandydatów ruchu. Dawne orderValues()/orderRooms() sortowały sloty i sale
+    // po zajętości, po czym sa() i tak brało z nich element jednostajnie - rozkład jest więc
+    // jednostajny na domenie i można losować z niej wprost, bez alokacji i sortowania.
+    int pickSlot(int v) {
+        const vector<int>& dom = slotDomain(vars[v].lessonIdx);
+        return dom[rng.below(dom.size())];
+    }
+
+    int pickRoom(int v) {
+        const vector<int>& dom = roomDomain(vars[v].lessonIdx);
+        return dom[rng.below(dom.size())];
+    }
+
+    // Losowa wolna dozwolona sala w slocie s (AND/popcount na bitsetach); gdy brak - dowolna dozwolona.
+    int pickFreeRoom(int v, int s) {
+        int l = vars[v].lessonIdx;
+        int freeRooms = bits::popcountAndNot(roomRow(l), busy.roomBits(s), roomSpanOf(l));
+        if (freeRooms == 0) return pickRoom(v);
+        return bits::selectAndNot(roomRow(l), busy.roomBits(s), roomSpanOf(l),
+                                  rng.below(freeRooms));
+    }
+
+    // Losuje zmienną ze zbioru konfliktów w O(1); gdy plan jest bezkonfliktowy - dowolną.
+    int pickVarBiased() {
+        if (!conflicted.empty()) {
+            return conflicted[rng.below(conflicted.size())];
+        }
+        return rng.below(vars.size());
+    }
+    // Dziennik zmiennych przestawionych przez applyMove() od ostatniego zapisu najlepszego planu:
+    // saveBest() kopiuje tylko je, więc kolejne poprawy w fazie schodzenia kosztują O(zmian),
+    // nie O(zmiennych). Po zmianach hurtowych (rebuild()) journalFull wymusza pełną kopię.
+    vector<int> journal;
+    vector<char> inJournal;
+    bool journalFull = true;
+
+    void touch(int v) {
+        if (v >= (int)inJournal.size()) journalFull = true;
+        else if (!inJournal[v]) {
+            inJournal[v] = 1;
+            journal.push_back(v);
+        }
+    }
+
+    void clearJournal() {
+        for (int v : journal) if (v < (int)inJournal.size()) inJournal[v] = 0;
+        journal.clear();
+        if (inJournal.size() != vars.size()) inJournal.assign(vars.size(), 0);
+        journalFull = false;
+    }
+
+    // bestAssign/bestAssignRooms := slotOf/roomOf.
+    void syncBest() {
+        if (journalFull || bestAssign.size() != slotOf.size()) {
+            bestAssign = slotOf;
+            bestAssignRooms = roomOf;
+        } else {
+            for (int v : journal) {
+                bestAssign[v] = slotOf[v];
+                bestAssignRooms[v] = roomOf[v];
+            }
+        }
+        clearJournal();
+    }
+
+    void saveBest() {
+        bestCost = curCost;
+        syncBest();
+        if (shared) shared->publish(bestCost);
+    }
+
+    // Żądanie przerwania albo miniony termin; silniki sprawdzają to co 1024 iteracje.
+    bool cancelled() const {
+        return (shared && shared->stopped()) || chrono::steady_clock::now() >= deadline;
+    }
+
+    // Pełna kopia - bestAssign mógł zostać podmieniony z zewnątrz (portfel, repliki pt).
+    void restoreBest() {
+        slotOf = bestAssign;
+        roomOf = bestAssignRooms;
+        rebuild();
+        clearJournal();
+    }
+
+    // Kanoniczny zapis najlepszego planu, np. przed eksportem. Wymienne godziny lekcji (przy blokach -
+    // całe bloki) idą rosnąco po slocie, a w każdym slocie sale jednej klasy są rozdane rosnąco
+    // zmiennym w kolejności numerów. Koszty się nie zmieniają, przypisanie do setAnchor() - tak.
+    void canonicalize() {
+        restoreBest();
+        vector<vector<pair<int, int>>> units;
+        for (int l = 0; l < (int)lessons.size(); ++l) {
+            auto [first, last] = varsOf(l);
+            if (last - first < 2) continue;
+            int b = blockLen[first], end = first;
+            units.clear();
+            for (; end + b <= last && blockLen[end] == b; end += b) {
+                units.emplace_back();
+                for (int x = end; x < end + b; ++x) units.back().push_back({slotOf[x], roomOf[x]});
+            }
+            sort(units.begin(), units.end());
+            int x = first;
+            for (auto& u : units) {
+                for (auto [s, r] : u) slotOf[x] = s, roomOf[x] = r, x++;
+            }
+        }
+        vector<vector<int>> inSlot(numSlots);
+        for (int v = 0; v < (int)vars.size(); ++v) inSlot[slotOf[v]].push_back(v);
+        vector<int> rs;
+        for (vector<int>& vs : inSlot) {
+            stable_sort(vs.begin(), vs.end(), [&](int a, int b) { return roomClass[roomOf[a]] < roomClass[roomOf[b]]; });
+            for (int i = 0, j = 0; i < (int)vs.size(); i = j) {
+                rs.clear();
+                for (j = i; j < (int)vs.size() && roomClass[roomOf[vs[j]]] == roomClass[roomOf[vs[i]]]; ++j) rs.push_back(roomOf[vs[j]]);
+                sort(rs.begin(), rs.end());
+                for (int k = i; k < j; ++k) roomOf[vs[k]] = rs[k - i];
+            }
+        }
+        rebuild();
+        syncBest();
+    }
+
+    // Zmiana kosztu własnego v i u po wymianie ich slotów i sal (jak deltaMove dla obu).
+    int deltaSwap(int v, int u) {
+        int sv = slotOf[v], rv = roomOf[v], su = slotOf[u], ru = roomOf[u];
+        int before = varCost[v] + varCost[u];
+        rawMove(v, su, ru);
+        rawMove(u, sv, rv);
+        int after = varCostRemovedSelf(v, su, ru) + varCostRemovedSelf(u, sv, rv);
+        rawMove(u, su, ru);
+        rawMove(v, sv, rv);
+        return after - before;
+    }
+
+    void applySwap(int v, int u) {
+        int sv = slotOf[v], rv = roomOf[v];
+        applyMove(v, slotOf[u], roomOf[u]);
+        applyMove(u, sv, rv);
+    }
+
+    // Czy lekcje x i y nie mogą dzielić slotu (krawędź grafu konfliktów).
+    bool clash(int x, int y) const {
+        const Lesson& X = lessons[vars[x].lessonIdx];
+        const Lesson& Y = lessons[vars[y].lessonIdx];
+        if (X.teacher == Y.teacher || X.group == Y.group) return true;
+        if (moves.kempeRooms && roomOf[x] == roomOf[y]) return true;
+        return bits::test(collRow(vars[x].lessonIdx), Y.group) || bits::test(collRow(vars[y].lessonIdx), X.group);
+    }
+
+    // Łańcuch Kempego: spójna składowa grafu konfliktów w slotach slotOf[v] i s2 zawierająca v.
+    // Wynik w buforze chain; false, gdy łańcuch przekracza moves.maxChain.
+    vector<int> chain;
+    vector<int> chainMark;
+    int chainStamp = 0;
+
+    bool buildChain(int v, int s2) {
+        int s1 = slotOf[v];
+        if (chainMark.size() != vars.size()) chainMark.assign(vars.size(), 0);
+        ++chainStamp;
+        chain.clear();
+        chain.push_back(v);
+        chainMark[v] = chainStamp;
+        for (int i = 0; i < (int)chain.size(); ++i) {
+            int x = chain[i];
+            for (int s : {s1, s2}) {
+                for (int y : slotVars[s]) {
+                    if (chainMark[y] == chainStamp || !clash(x, y)) continue;
+                    if ((int)chain.size() >= moves.maxChain || blockLen[y] > 1) return false;
+                    chainMark[y] = chainStamp;
+                    chain.push_back(y);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Zmiana sumy kosztów własnych lekcji łańcucha po zamianie slotów s1 <-> s2 (sale bez zmian).
+    int deltaChain(int s1, int s2) {
+        int before = 0, after = 0;
+        for (int x : chain) {
+            before += varCost[x];
+            rawMove(x, slotOf[x] == s1 ? s2 : s1, roomOf[x]);
+        }
+        for (int x : chain) after += varCostRemovedSelf(x, slotOf[x], roomOf[x]);
+        for (int x : chain) rawMove(x, slotOf[x] == s1 ? s2 : s1, roomOf[x]);
+        return after - before;
+    }
+
+    void applyChain(int s1, int s2) {
+        for (int x : chain) applyMove(x, slotOf[x] == s1 ? s2 : s1, roomOf[x]);
+    }
+
+    // Bloki (Lesson::block > 1): kolejne zmienne jednej lekcji stoją w kolejnych slotach jednego
+    // dnia i zmieniają slot tylko razem - przez ruch bloku w sa()/tabu()/repair()/saSoft(); wymiana
+    // i łańcuch Kempego ich nie ruszają, a zmiana samej sali działa na pojedynczą godzinę.
+    // blockFirst[v] to pierwsza zmienna bloku v, blockLen[v] jego długość (1 dla zwykłej godziny),
+    // nextSlot[s] - slot o jedną lekcję później tego samego dnia albo -1.
+    vector<int> blockFirst, blockLen, nextSlot;
+    // Cel ruchu bloku (planBlock()), jego miejsce sprzed deltaBlock() i sale najlepszego celu w tabu()/repair().
+    vector<int> blockSlots, blockRooms, bestBlockRooms;
+    vector<pair<int, int>> blockUndo;
+
+    // Bloki z Lesson::block; zmienne lekcji leżą w vars kolejno po idx.
+    void initBlocks() {
+        blockFirst.resize(vars.size());
+        blockLen.resize(vars.size());
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            const Lesson& L = lessons[vars[v].lessonIdx];
+            int b = max(1, L.block), i = vars[v].idx;
+            blockFirst[v] = v - i % b;
+            blockLen[v] = min(b, L.hours - (i - i % b));
+        }
+    }
+
+    bool blockIntact(int h) const {
+        for (int x = h + 1; x < h + blockLen[h]; ++x) {
+            if (slotOf[x - 1] < 0 || slotOf[x] != nextSlot[slotOf[x - 1]]) return false;
+        }
+        return true;
+    }
+
+    // Sloty bloku h zaczynającego się w s do blockSlots, wolne (jeśli są) sale do blockRooms.
+    // false, gdy dzień kończy się przed końcem bloku.
+    bool planBlock(int h, int s) {
+        blockSlots.clear();
+        blockRooms.clear();
+        for (int x = h; x < h + blockLen[h]; ++x, s = nextSlot[s]) {
+            if (s < 0) return false;
+            blockSlots.push_back(s);
+            blockRooms.push_back(pickFreeRoom(x, s));
+        }
+        return true;
+    }
+
+    // Jak deltaChain(): zmiana sumy kosztów własnych godzin bloku h po przeniesieniu do planBlock().
+    int deltaBlock(int h) {
+        int n = blockLen[h], before = 0, after = 0;
+        blockUndo.clear();
+        for (int i = 0; i < n; ++i) {
+            before += varCost[h + i];
+            blockUndo.push_back({slotOf[h + i], roomOf[h + i]});
+            rawMove(h + i, blockSlots[i], blockRooms[i]);
+        }
+        for (int i = 0; i < n; ++i) after += varCostRemovedSelf(h + i, blockSlots[i], blockRooms[i]);
+        for (int i = 0; i < n; ++i) rawMove(h + i, blockUndo[i].first, blockUndo[i].second);
+        return after - before;
+    }
+
+    void applyBlock(int h) {
+        blockUndo.clear();
+        for (int i = 0; i < blockLen[h]; ++i) {
+            blockUndo.push_back({slotOf[h + i], roomOf[h + i]});
+            applyMove(h + i, blockSlots[i], blockRooms[i]);
+        }
+        if (!moves.matchRooms) return;
+        for (auto [s0, r0] : blockUndo) matchSlotRooms(s0);
+        for (int s : blockSlots) matchSlotRooms(s);
+    }
+
+    // Przeniesienie bloku h w losowe miejsce jego domeny.
+    bool stepBlock(int h, double T) {
+        int ns = TELEMETRY_TIME(Pick, pickSlot(h));
+        if (ns == slotOf[h] || !TELEMETRY_TIME(Pick, planBlock(h, ns))) return false;
+        TELEMETRY(telemetry.propose(Telemetry::Block));
+        if (!accept(TELEMETRY_TIME(Delta, deltaBlock(h)), T)) return false;
+        TELEMETRY_TIME(Apply, applyBlock(h));
+        TELEMETRY(telemetry.accept(Telemetry::Block));
+        if (curCost < bestCost) saveBest();
+        return true;
+    }
+
+    // Skojarzenie lekcji ze salami w obrębie slotu (ścieżki powiększające Kuhna).
+    // findRoomPath(x, s) szuka dla x sali w slocie s, przesuwając lekcje po ścieżce naprzemiennej;
+    // wynik w path od końca ścieżki do x (path.back().first == x), w kolejności do zastosowania.
+    vector<pair<int,int>> path;
+    vector<int> roomOwner, roomSeen;
+    int roomStamp = 0;
+
+    bool augment(int x, int s) {
+        int l = vars[x].lessonIdx;
+        int freeRooms = bits::popcountAndNot(roomRow(l), busy.roomBits(s), roomSpanOf(l));
+        if (freeRooms > 0) {
+            int r = bits::selectAndNot(roomRow(l), busy.roomBits(s), roomSpanOf(l),
+                                       rng.below(freeRooms));
+            path.push_back({x, r});
+            return true;
+        }
+        for (int r : roomDomain(l)) {
+            if (roomSeen[r] == roomStamp) continue;
+            roomSeen[r] = roomStamp;
+            if (busy.room(s, r) != 1) continue;
+            int u = roomOwner[r];
+            if (u == x || slotOf[u] != s || roomOf[u] != r) continue;
+            if (augment(u, s)) {
+                path.push_back({x, r});
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findRoomPath(int x, int s) {
+        if ((int)roomOwner.size() != numRooms) {
+            roomOwner.assign(numRooms, 0);
+            roomSeen.assign(numRooms, 0);
+        }
+        // Wpisy nieaktualne są odrzucane w augment() przez sprawdzenie slotOf/roomOf właściciela.
+        for (int u : slotVars[s]) if (busy.room(s, roomOf[u]) == 1) roomOwner[roomOf[u]] = u;
+        ++roomStamp;
+        path.clear();
+        return augment(x, s);
+    }
+
+    void applyRoomPath(int s) {
+        for (auto [x, r] : path) applyMove(x, s, r);
+    }
+
+    // Próbuje usunąć konflikty sal w slocie s, szukając ścieżki dla każdej lekcji we wspólnej sali.
+    void matchSlotRooms(int s) {
+        for (int i = 0; i < (int)slotVars[s].size(); ++i) {
+            int u = slotVars[s][i];
+            if (busy.room(s, roomOf[u]) > 1 && findRoomPath(u, s)) applyRoomPath(s);
+        }
+    }
+
+    void matchAllRooms() {
+        for (int s = 0; s < numSlots; ++s) matchSlotRooms(s);
+    }
+
+    // Przeniesienie v do slotu ns z salą z skojarzenia; koszt sali liczony po przesunięciu ścieżki.
+    bool stepMatched(int v, int ns, double T) {
+        int s0 = slotOf[v];
+        if (ns == s0) return false;
+        TELEMETRY(telemetry.propose(Telemetry::Matched));
+        bool found = TELEMETRY_TIME(Pick, findRoomPath(v, ns));
+        int nr = found ? path.back().second : pickRoom(v);
+        int d = TELEMETRY_TIME(Delta, deltaMove(v, ns, nr)) - (found && busy.room(ns, nr) > 0 ? W_ROOM : 0);
+        if (!accept(d, T)) return false;
+        TELEMETRY_TIME(Apply, [&] {
+            if (found) applyRoomPath(ns);
+            else applyMove(v, ns, nr);
+            matchSlotRooms(s0);
+        }());
+        TELEMETRY(telemetry.accept(Telemetry::Matched));
+        if (curCost < bestCost) saveBest();
+        return true;
+    }
+
+    // Liczniki pogorszeń proponowanych i przyjętych - sygnał dla saAdaptive().
+    long long uphillTried = 0, uphillTaken = 0;
+
+    // Progi przyjęcia pogorszenia d = 1..ACCEPT_TABLE w temperaturze acceptT: exp(-d/T) w skali 2^53,
+    // porównywane z 53 losowymi bitami. Tablica liczy się od nowa tylko przy zmianie T (sa() trzyma
+    // T stałe przez 64 iteracje), większe delty wołają exp() jak dawniej.
+    static constexpr int ACCEPT_TABLE = 64;
+    array<uint64_t, ACCEPT_TABLE + 1> acceptThr{};
+    double acceptT = -1;
+
+    void fillAcceptTable(double T) {
+        acceptT = T;
+        double q = exp(-1.0 / max(1e-9, T)), p = 1.0;
+        for (int d = 1; d <= ACCEPT_TABLE; ++d) acceptThr[d] = (uint64_t)((p *= q) * 0x1p53);
+    }
+
+    bool accept(int d, double T) {
+        if (d <= 0) return true;
+        uphillTried++;
+        if (T != acceptT) fillAcceptTable(T);
+        uint64_t u = rng() >> 11;
+        bool ok = d <= ACCEPT_TABLE ? u < acceptThr[d] : u * 0x1p-53 < exp(-d / max(1e-9, T));
+        uphillTaken += ok;
+        return ok;
+    }
+
+    // Jedna iteracja Metropolisa w temperaturze T; zwraca true, gdy ruch został przyjęty.
+    bool step(double T) {
+        int v = TELEMETRY_TIME(Pick, pickVarBiased());
+
+        int s0 = slotOf[v];
+        int r0 = roomOf[v];
+        int ns = s0;
+        int nr = r0;
+        TELEMETRY(Telemetry::Move kind = Telemetry::Slot);
+
+        double z = rng.uniform();
+        // Pasmo [0, room) bez ruchu samej sali idzie na przeniesienie, nie na wymianę.
+        if (moves.matchRooms && z < moves.room) z = 1.0;
+        bool roomOnly = z < moves.room;
+        if (blockLen[v] > 1 && !roomOnly) return stepBlock(blockFirst[v], T);
+        if (roomOnly) {
+            TELEMETRY(kind = Telemetry::Room);
+            nr = TELEMETRY_TIME(Pick, pickRoom(v));
+            // Inna sala tej samej klasy to ten sam plan, chyba że v dzieli salę z inną lekcją.
+            if (roomClass[nr] == roomClass[r0] && busy.room(s0, r0) == 1) return false;
+            nr = freeInClass(nr, s0);
+        } else if (z < moves.room + moves.swap + moves.kempe) {
+            ns = TELEMETRY_TIME(Pick, pickSlot(v));
+            if (ns == s0) return false;
+            if (z < moves.room + moves.swap) {
+                const vector<int>& there = slotVars[ns];
+                if (there.empty()) return false;
+                int u = there[rng.below(there.size())];
+                // Godziny jednej lekcji są wymienne - ich zamiana nic nie zmienia.
+                if (blockLen[u] > 1 || vars[u].lessonIdx == vars[v].lessonIdx) return false;
+                TELEMETRY(telemetry.propose(Telemetry::Swap));
+                if (!accept(TELEMETRY_TIME(Delta, deltaSwap(v, u)), T)) return false;
+                TELEMETRY_TIME(Apply, applySwap(v, u));
+                TELEMETRY(telemetry.accept(Telemetry::Swap));
+            } else {
+                if (!TELEMETRY_TIME(Pick, buildChain(v, ns))) return false;
+                TELEMETRY(telemetry.propose(Telemetry::Kempe));
+                if (!accept(TELEMETRY_TIME(Delta, deltaChain(s0, ns)), T)) return false;
+                TELEMETRY_TIME(Apply, applyChain(s0, ns));
+                TELEMETRY(telemetry.accept(Telemetry::Kempe));
+            }
+            if (moves.matchRooms) {
+                TELEMETRY_TIME(Apply, matchSlotRooms(s0));
+                TELEMETRY_TIME(Apply, matchSlotRooms(ns));
+            }
+            if (curCost < bestCost) saveBest();
+            return true;
+        } else {
+            ns = TELEMETRY_TIME(Pick, pickSlot(v));
+            if (moves.matchRooms) return stepMatched(v, ns, T);
+            nr = TELEMETRY_TIME(Pick, moves.freeRoom ? pickFreeRoom(v, ns) : pickRoom(v));
+        }
+
+        TELEMETRY(telemetry.propose(kind));
+        if (accept(TELEMETRY_TIME(Delta, deltaMove(v, ns, nr)), T)) {
+            TELEMETRY_TIME(Apply, applyMove(v, ns, nr));
+            TELEMETRY(telemetry.accept(kind));
+            if (curCost < bestCost) saveBest();
+            return true;
+        }
+        return false;
+    }
+
+    // Zwraca liczbę wykonanych iteracji.
+    // Co checkpointEvery iteracji sa() woła onCheckpoint(iteracja, T), np. żeby zapisać stan na dysk.
+    int checkpointEvery = 0;
+    function<void(int, double)> onCheckpoint;
+    // Co 1024 iteracje sa()/saAdaptive() wołają onProgress(iteracja, koszt bieżący, najlepszy),
+    // np. żeby pokazać postęp w GUI. W portfelu woła go każdy uczestnik ze swojego wątku.
+    function<void(int, int, int)> onProgress;
+
+    // startIt > 0 wznawia przerwany przebieg: T0 to wtedy temperatura z punktu kontrolnego,
+    // a najlepszy plan sprzed przerwania zostaje, o ile bieżący nie jest lepszy. Bez wznowienia
+    // punktem startowym jest bieżący plan, także przy kolejnym sa() na tym samym solverze.
+    // Temperatura spada o alpha^64 co 64 iteracje (granice bloków liczone od iteracji 0), żeby
+    // tablica progów accept() przeliczała się raz na blok.
+    int sa(int maxIters = 400000, double T0 = 5.0, double alpha = 0.9995, int startIt = 0) {
+        if (startIt == 0 || curCost <= bestCost) saveBest();
+
+        const double alpha64 = pow(alpha, 64);
+        double T = T0;
+        int it = startIt, nextCheckpoint = startIt + checkpointEvery;
+        TELEMETRY(telemetry.begin());
+        for (; it < maxIters && bestCost > 0; it++) {
+            if ((it & 1023) == 0) {
+                if (cancelled()) break;
+                if (onProgress) onProgress(it, curCost, bestCost);
+                if (checkpointEvery > 0 && it >= nextCheckpoint && onCheckpoint) {
+                    // Po rebuild() kolejność zbioru konfliktów jest taka jak po wczytaniu punktu,
+                    // więc wznowiony przebieg powtarza dalszy ciąg tego przebiegu co do ruchu.
+                    rebuild();
+                    onCheckpoint(it, T);
+                    nextCheckpoint = it + checkpointEvery;
+                }
+            }
+            [[maybe_unused]] bool acc = step(T);
+            TELEMETRY(telemetry.tick(it, T, acc, curCost, bestCost));
+            if ((it & 63) == 63) T *= alpha64;
+        }
+
+        restoreBest();
+        return it;
+    }
+
+    // Temperatura, w której średnie pogorszenie z `samples` losowych ruchów (deltaMove bez
+    // wykonania) jest przyjmowane z prawdopodobieństwem ratio. Gdy żaden ruch nie pogarsza - 1.0.
+    double calibrateT(double ratio, int samples) {
+        long long sum = 0;
+        int n = 0;
+        for (int k = 0; k < samples; ++k) {
+            int v = pickVarBiased();
+            int ns = pickSlot(v);
+            int d = deltaMove(v, ns, moves.freeRoom || moves.matchRooms ? pickFreeRoom(v, ns) : pickRoom(v));
+            if (d > 0) sum += d, n++;
+        }
+        return n == 0 ? 1.0 : -((double)sum / n) / log(ratio);
+    }
+
+    // sa() z harmonogramem adaptacyjnym (patrz Cooling); zwraca liczbę wykonanych iteracji.
+    int saAdaptive(const Cooling& c) {
+        saveBest();
+        auto t0 = chrono::steady_clock::now();
+        double T = calibrateT(c.acceptStart, c.samples);
+        double start = c.acceptStart;
+        int epochStart = 0, lastBest = 0, best = bestCost;
+        long long tried = uphillTried, taken = uphillTaken;
+        TELEMETRY(telemetry.begin());
+
+        int it = 0;
+        for (; it < c.maxIters && bestCost > 0; it++) {
+            if ((it & 1023) == 0 && onProgress) onProgress(it, curCost, bestCost);
+            if (it % c.window == 0 && it > 0) {
+                if (cancelled()) break;
+                if (c.maxSeconds > 0 && chrono::duration<double>(chrono::steady_clock::now() - t0).count() >= c.maxSeconds) break;
+                if (bestCost < best) best = bestCost, lastBest = it;
+                if (c.stallIters > 0 && it - lastBest >= c.stallIters) break;
+
+                if (c.reheatAfter > 0 && it - max(lastBest, epochStart) >= c.reheatAfter) {
+                    epochStart = it;
+                    start = c.acceptReheat;
+                    T = calibrateT(start, c.samples);
+                } else if (uphillTried > tried) {
+                    // Cel maleje geometrycznie w epoce; T rośnie, gdy przyjmujemy za mało, i maleje, gdy za dużo.
+                    double progress = min(1.0, (double)(it - epochStart) / c.epochIters);
+                    double target = start * pow(c.acceptEnd / start, progress);
+                    double rate = (double)(uphillTaken - taken) / (uphillTried - tried);
+                    T *= clamp(pow((target + 1e-4) / (rate + 1e-4), 0.3), 0.8, 1.25);
+                }
+                tried = uphillTried;
+                taken = uphillTaken;
+            }
+            [[maybe_unused]] bool acc = step(T);
+            TELEMETRY(telemetry.tick(it, T, acc, curCost, bestCost));
+        }
+
+        restoreBest();
+        return it;
+    }
+
+    // Tabu search na tych samych strukturach co sa(). W każdej iteracji ocenia deltaMove()
+    // wszystkich slotów (z wolną salą, jeśli jest) dla kilku lekcji ze zbioru konfliktów
+    // i wykonuje najlepszy ruch nietabu; ruch tabu przechodzi, gdy dałby nowy najlepszy koszt.
+    // Powrót lekcji do opuszczonego slotu jest tabu przez tenure + losowo do tenureRand
+    // + tenureConf * |konflikty| iteracji - dla każdej jej godziny, bo godziny są wymienne.
+    // Blok jest oceniany i przenoszony w całości (deltaBlock()), tabu dotyczy wtedy slotu jego
+    // pierwszej godziny. Zwraca liczbę wykonanych iteracji.
+    Table<int> tabuUntil;
+
+    int tabu(int maxIters = 200000, int sample = 8, int tenure = 10, int tenureRand = 10, double tenureConf = 0.6) {
+        if (tabuUntil.rows != (int)lessons.size() || tabuUntil.cols != numSlots) tabuUntil.assign(lessons.size(), numSlots, 0);
+        else fill(tabuUntil.data.begin(), tabuUntil.data.end(), 0);
+        saveBest();
+
+        int it = 0;
+        for (; it < maxIters && bestCost > 0; it++) {
+            if ((it & 1023) == 0 && cancelled()) break;
+            int bestV = -1, bestS = -1, bestR = -1, bestD = INT_MAX, ties = 0;
+            for (int k = 0; k < sample; ++k) {
+                int v = pickVarBiased();
+                int s0 = slotOf[v];
+                if (blockLen[v] > 1) {
+                    int h = blockFirst[v];
+                    for (int s : slotDomain(vars[h].lessonIdx)) {
+                        if (s == slotOf[h] || !planBlock(h, s)) continue;
+                        int d = deltaBlock(h);
+                        if (tabuUntil[vars[h].lessonIdx][s] > it && curCost + d >= bestCost) continue;
+                        if (d < bestD || (d == bestD && rng.below(++ties) == 0)) {
+                            if (d < bestD) ties = 1;
+                            bestD = d; bestV = h; bestS = s;
+                            bestBlockRooms = blockRooms;
+                        }
+                    }
+                    continue;
+                }
+                for (int s : slotDomain(vars[v].lessonIdx)) {
+                    if (s == s0 && busy.room(s0, roomOf[v]) <= 1) continue;
+                    int r = pickFreeRoom(v, s);
+                    if (s == s0 && r == roomOf[v]) continue;
+                    int d = deltaMove(v, s, r);
+                    bool isTabu = s != s0 && tabuUntil[vars[v].lessonIdx][s] > it;
+                    if (isTabu && curCost + d >= bestCost) continue;
+                    if (d < bestD) {
+                        bestD = d; bestV = v; bestS = s; bestR = r; ties = 1;
+                    } else if (d == bestD && rng.below(++ties) == 0) {
+                        bestV = v; bestS = s; bestR = r;
+                    }
+                }
+            }
+            if (bestV < 0) continue;
+
+            int s0 = slotOf[bestV];
+            if (bestS != s0) {
+                tabuUntil[vars[bestV].lessonIdx][s0] = it + tenure + rng.below(tenureRand + 1) +
+                                       (int)(tenureConf * conflicted.size());
+            }
+            if (blockLen[bestV] > 1) {
+                planBlock(bestV, bestS);
+                blockRooms = bestBlockRooms;
+                applyBlock(bestV);
+                if (curCost < bestCost) saveBest();
+                continue;
+            }
+            applyMove(bestV, bestS, bestR);
+            if (moves.matchRooms && bestS != s0) matchSlotRooms(s0);
+            if (curCost < bestCost) saveBest();
+        }
+
+        restoreBest();
+        return it;
+    }
+
+    // ====== RE-SOLVE PO DROBNYCH ZMIANACH ======
+    // Edycje poniżej zmieniają instancję w miejscu (liczniki, maski domen, koszty), nie ruszając
+    // planu; repair() naprawia potem tylko zmienne ze zbioru konfliktów, czyli otoczenie edycji.
+    // Przesunięcie zmiennej z miejsca w planie odniesienia (setAnchor()) kosztuje anchorWeight.
+    // Domeny dodawane przez edycje trafiają tylko do dom solvera, nie do Instance::domains.
+    // Najlepszy plan sprzed edycji był liczony na innej instancji, więc każda edycja kończy się
+    // saveBest(): najlepszym staje się bieżący plan z nowym kosztem.
+    vector<int> anchorSlot, anchorRoom;
+
+    void setAnchor() {
+        anchorSlot = slotOf;
+        anchorRoom = roomOf;
+    }
+    // Godziny lekcji są wymienne: v jest na miejscu, gdy którakolwiek godzina jej lekcji była w (s, r).
+    bool moved(int v, int s, int r) const {
+        if (v >= (int)anchorSlot.size() || anchorSlot[v] < 0) return false;
+        auto [first, last] = varsOf(vars[v].lessonIdx);
+        for (int u = first; u < min(last, (int)anchorSlot.size()); ++u) {
+            if (anchorSlot[u] == s && anchorRoom[u] == r) return false;
+        }
+        return true;
+    }
+
+    // Zmienne lekcji l to przedział [first, last) - vars są ułożone rosnąco po lessonIdx.
+    pair<int, int> varsOf(int l) const {
+        auto cmp = [](const Variable& x, int l) { return x.lessonIdx < l; };
+        int first = lower_bound(vars.begin(), vars.end(), l, cmp) - vars.begin();
+        int last = lower_bound(vars.begin() + first, vars.end(), l + 1, cmp) - vars.begin();
+        return {first, last};
+    }
+    void refreshLesson(int l) {
+        auto [first, last] = varsOf(l);
+        for (int v = first; v < last; ++v) setCost(v, varCostRemovedSelf(v, slotOf[v], roomOf[v]));
+    }
+
+    void changeSlotDomain(int l, vector<int> s) {
+        setSlotDomain(l, move(s));
+        refreshLesson(l);
+        saveBest();
+    }
+    void changeRoomDomain(int l, vector<int> r) {
+        setRoomDomain(l, move(r));
+        refreshLesson(l);
+        saveBest();
+    }
+
+    // Blokuje (on) albo odblokowuje nauczyciela t / salę r w podanych slotach.
+    void blockTeacher(int t, const vector<int>& slots, bool on = true) {
+        for (int s : slots) {
+            if (!on && pinned.teacher(s, t) == 0) continue;
+            pinned.addTeacher(s, t, on ? 1 : -1);
+            busy.addTeacher(s, t, on ? 1 : -1);
+            refreshSlot(s, t, -1, -1, -1);
+        }
+        saveBest();
+    }
+    void blockRoom(int r, const vector<int>& slots, bool on = true) {
+        for (int s : slots) {
+            if (!on && pinned.room(s, r) == 0) continue;
+            pinned.addRoom(s, r, on ? 1 : -1);
+            busy.addRoom(s, r, on ? 1 : -1);
+            refreshSlot(s, -1, -1, r, -1);
+        }
+        saveBest();
+    }
+
+    // Dodaje lekcję o podanych domenach i rozmieszcza jej godziny (bloki) zachłannie. Zwraca jej indeks.
+    int addLesson(Lesson L, const vector<int>& slots, const vector<int>& roomsAllowed, const vector<int>& coll) {
+        int l = lessons.size();
+        L.id = l;
+        lessons.push_back(L);
+        slotSetOf.push_back(0);
+        roomSetOf.push_back(0);
+        collSetOf.push_back(0);
+        setSlotDomain(l, slots);
+        setRoomDomain(l, roomsAllowed);
+        int before = dom.groups.size();
+        collSetOf[l] = dom.groups.add(coll);
+        if (dom.groups.size() > before) {
+            collBits.appendRow(0);
+            for (int g : dom.groups[collSetOf[l]]) bits::set(collBits[collSetOf[l]], g);
+            collSpan.push_back(bits::span(collBits[collSetOf[l]], collBits.cols));
+        }
+        lessons[l].possibleSlots = slotSetOf[l];
+        lessons[l].possibleRooms = roomSetOf[l];
+        lessons[l].colidingGroups = collSetOf[l];
+
+        int first = vars.size();
+        for (int i = 0; i < L.hours; ++i) {
+            int v = vars.size();
+            vars.push_back({v, l, i});
+            for (auto* a : { &slotOf, &roomOf, &bestAssign, &bestAssignRooms, &slotPos, &conflictPos }) a->push_back(-1);
+            varCost.push_back(0);
+        }
+        initBlocks();
+        vector<int> candS;
+        for (int v = first; v < (int)vars.size(); v += blockLen[v]) {
+            if (blockLen[v] > 1) placeBlockGreedy(v, candS);
+            else placeGreedy(v, candS);
+        }
+        rebuild();
+        saveBest();
+        return l;
+    }
+
+    // Usuwa godziny lekcji l z planu; lekcja zostaje w lessons z hours == 0, więc indeksy się nie zmieniają.
+    void removeLesson(int l) {
+        auto [first, last] = varsOf(l);
+        vars.erase(vars.begin() + first, vars.begin() + last);
+        for (int v = first; v < (int)vars.size(); ++v) vars[v].id = v;
+        for (auto* a : { &slotOf, &roomOf, &bestAssign, &bestAssignRooms, &slotPos, &conflictPos, &varCost }) {
+            a->erase(a->begin() + first, a->begin() + last);
+        }
+        for (auto* a : { &anchorSlot, &anchorRoom }) {
+            if ((int)a->size() >= last) a->erase(a->begin() + first, a->begin() + last);
+        }
+        lessons[l].hours = 0;
+        initBlocks();
+        rebuild();
+        saveBest();
+    }
+
+    // Naprawa po edycjach: bierze zmienną ze zbioru konfliktów i przenosi ją do najlepszego
+    // slotu (z wolną salą, jeśli jest) wg deltaMove() + kary za odsunięcie od planu odniesienia;
+    // gorszy ruch przechodzi z prawdopodobieństwem exp(-delta / T). Blok przenoszony jest w całości.
+    // Kończy na koszcie 0 albo po maxIters. Zwraca liczbę iteracji.
+    int repair(int maxIters = 200000, double anchorWeight = 0.2, double T = 0.3) {
+        saveBest();
+        int it = 0;
+        for (; it < maxIters && bestCost > 0; ++it) {
+            if ((it & 1023) == 0 && cancelled()) break;
+            int v = pickVarBiased();
+            if (blockLen[v] > 1) {
+                repairBlock(blockFirst[v], anchorWeight, T);
+                continue;
+            }
+            int s0 = slotOf[v], r0 = roomOf[v];
+            double stay = anchorWeight * moved(v, s0, r0);
+            double best = INFINITY;
+            int bs = -1, br = -1, ties = 0;
+            for (int s : slotDomain(vars[v].lessonIdx)) {
+                int r = pickFreeRoom(v, s);
+                if (s == s0 && r == r0) continue;
+                double d = deltaMove(v, s, r) + anchorWeight * moved(v, s, r) - stay;
+                if (d < best) {
+                    best = d; bs = s; br = r; ties = 1;
+                } else if (d == best && rng.below(++ties) == 0) {
+                    bs = s; br = r;
+                }
+            }
+            if (bs < 0) continue;
+            if (best <= 0 || rng.uniform() < exp(-best / T)) {
+                applyMove(v, bs, br);
+                if (curCost < bestCost) saveBest();
+            }
+        }
+        restoreBest();
+        return it;
+    }
+
+    // Krok repair() dla bloku h: najlepszy start wg deltaBlock() + kary za odsunięcie godzin.
+    void repairBlock(int h, double anchorWeight, double T) {
+        auto anchored = [&](const vector<int>& slots, const vector<int>& roomsOf) {
+            double a = 0;
+            for (int i = 0; i < blockLen[h]; ++i) a += anchorWeight * moved(h + i, slots[i], roomsOf[i]);
+            return a;
+        };
+        vector<int> curSlots(slotOf.begin() + h, slotOf.begin() + h + blockLen[h]);
+        vector<int> curRooms(roomOf.begin() + h, roomOf.begin() + h + blockLen[h]);
+        double stay = anchored(curSlots, curRooms), best = INFINITY;
+        int bs = -1, ties = 0;
+        for (int s : slotDomain(vars[h].lessonIdx)) {
+            if (s == slotOf[h] || !planBlock(h, s)) continue;
+            double d = deltaBlock(h) + anchored(blockSlots, blockRooms) - stay;
+            if (d < best || (d == best && rng.below(++ties) == 0)) {
+                if (d < best) ties = 1;
+                best = d; bs = s;
+                bestBlockRooms = blockRooms;
+            }
+        }
+        if (bs < 0 || (best > 0 && rng.uniform() >= exp(-best / T))) return;
+        planBlock(h, bs);
+        blockRooms = bestBlockRooms;
+        applyBlock(h);
+        if (curCost < bestCost) saveBest();
+    }
+
+    // ====== OGRANICZENIA MIĘKKIE ======
+    // Koszt miękki (softCost) jest liczony osobno od twardego i tylko po enableSoft(): do tego
+    // czasu sa()/tabu() płacą za niego jednym nieskokowym warunkiem w rawMove()/applyMove().
+    // Stan to maski zajętych lekcji w dniu dla każdego (nauczyciel, dzień) i (grupa, dzień)
+    // oraz liczba godzin lekcji w dniu; ruch zmienia co najwyżej dwa dni każdej z nich, więc
+    // softMoveDelta() ocenia go w O(1) z popcount/clz/ctz na maskach. Maski widzą tylko zmienne,
+    // nie blokady z blockTeacher().
+    SoftWeights soft;
+    bool softOn = false;
+    int softCost = 0, bestSoft = INT_MAX;
+    int numDays = 0;
+    vector<int> dayOf, periodOf;
+    vector<uint64_t> teacherDay, groupDay;
+    vector<int> lessonDay;
+
+    static int gaps(uint64_t m) { return m ? 64 - __builtin_clzll(m) - __builtin_ctzll(m) - __builtin_popcountll(m) : 0; }
+    int dayCost(uint64_t m) const {
+        int n = __builtin_popcountll(m);
+        return soft.gap * gaps(m) + soft.load * n * n;
+    }
+
+    // Włącza warstwę miękką dla wag soft; false, gdy wagi są zerowe albo dzień ma ponad 64 lekcje.
+    bool enableSoft() {
+        if (!soft.any()) return false;
+        dayOf.resize(numSlots);
+        periodOf.resize(numSlots);
+        numDays = 0;
+        for (int s = 0; s < numSlots; ++s) {
+            dayOf[s] = allSlots[s].day;
+            periodOf[s] = allSlots[s].period;
+            if (periodOf[s] < 0 || periodOf[s] >= 64 || dayOf[s] < 0) return false;
+            numDays = max(numDays, dayOf[s] + 1);
+        }
+        softOn = true;
+        rebuildSoft();
+        return true;
+    }
+
+    void rebuildSoft() {
+        teacherDay.assign((size_t)numTeachers * numDays, 0);
+        groupDay.assign((size_t)numGroups * numDays, 0);
+        lessonDay.assign(lessons.size() * numDays, 0);
+        for (int v = 0; v < (int)vars.size(); ++v) {
+            const Lesson& L = lessons[vars[v].lessonIdx];
+            int s = slotOf[v], d = dayOf[s];
+            teacherDay[L.teacher * numDays + d] |= uint64_t(1) << periodOf[s];
+            groupDay[L.group * numDays + d] |= uint64_t(1) << periodOf[s];
+            lessonDay[vars[v].lessonIdx * numDays + d]++;
+        }
+        softCost = 0;
+        for (uint64_t m : teacherDay) softCost += dayCost(m);
+        for (uint64_t m : groupDay) softCost += dayCost(m);
+        for (int c : lessonDay) softCost += soft.spread * c * (c - 1) / 2;
+    }
+
+    // Zmienne nauczyciela t (grupy g) w slocie s, bez blokad.
+    int teacherVars(int s, int t) { return busy.teacher(s, t) - pinned.teacher(s, t); }
+    int groupVars(int s, int g) { return busy.group(s, g) - pinned.group(s, g); }
+
+    // Po przestawieniu liczników busy lekcji l ze slotu s0 do s1.
+    void moveSoftMasks(int l, int s0, int s1) {
+        const Lesson& L = lessons[l];
+        uint64_t b0 = uint64_t(1) << periodOf[s0], b1 = uint64_t(1) << periodOf[s1];
+        int d0 = dayOf[s0], d1 = dayOf[s1];
+        if (teacherVars(s0, L.teacher) == 0) teacherDay[L.teacher * numDays + d0] &= ~b0;
+        if (groupVars(s0, L.group) == 0) groupDay[L.group * numDays + d0] &= ~b0;
+        teacherDay[L.teacher * numDays + d1] |= b1;
+        groupDay[L.group * numDays + d1] |= b1;
+        lessonDay[l * numDays + d0]--;
+        lessonDay[l * numDays + d1]++;
+    }
+
+    // Zmiana softCost po przeniesieniu v do slotu ns (sala nie ma znaczenia).
+    int softMoveDelta(int v, int ns) {
+        int s0 = slotOf[v];
+        if (ns == s0) return 0;
+        int l = vars[v].lessonIdx;
+        const Lesson& L = lessons[l];
+        int d0 = dayOf[s0], d1 = dayOf[ns];
+        uint64_t b0 = uint64_t(1) << periodOf[s0], b1 = uint64_t(1) << periodOf[ns];
+        auto entity = [&](uint64_t* day, bool sole) {
+            uint64_t m0 = day[d0], m0n = sole ? m0 & ~b0 : m0;
+            if (d0 == d1) return dayCost(m0n | b1) - dayCost(m0);
+            return dayCost(m0n) - dayCost(m0) + dayCost(day[d1] | b1) - dayCost(day[d1]);
+        };
+        int delta = entity(&teacherDay[L.teacher * numDays], teacherVars(s0, L.teacher) == 1) +
+                    entity(&groupDay[L.group * numDays], groupVars(s0, L.group) == 1);
+        if (d0 != d1) delta += soft.spread * (lessonDay[l * numDays + d1] - (lessonDay[l * numDays + d0] - 1));
+        return delta;
+    }
+
+    // Jak deltaSwap()/deltaChain(), ale dla kosztu miękkiego: ruchy składowe na próbę, potem z powrotem.
+    int softDeltaSwap(int v, int u) {
+        int sv = slotOf[v], rv = roomOf[v], su = slotOf[u], ru = roomOf[u];
+        int d = softMoveDelta(v, su);
+        rawMove(v, su, ru);
+        d += softMoveDelta(u, sv);
+        rawMove(u, sv, rv);
+        rawMove(u, su, ru);
+        rawMove(v, sv, rv);
+        return d;
+    }
+
+    int softDeltaBlock(int h) {
+        int n = blockLen[h], d = 0;
+        blockUndo.clear();
+        for (int i = 0; i < n; ++i) {
+            d += softMoveDelta(h + i, blockSlots[i]);
+            blockUndo.push_back({slotOf[h + i], roomOf[h + i]});
+            rawMove(h + i, blockSlots[i], blockRooms[i]);
+        }
+        for (int i = 0; i < n; ++i) rawMove(h + i, blockUndo[i].first, blockUndo[i].second);
+        return d;
+    }
+
+    int softDeltaChain(int s1, int s2) {
+        int d = 0;
+        for (int x : chain) {
+            int to = slotOf[x] == s1 ? s2 : s1;
+            d += softMoveDelta(x, to);
+            rawMove(x, to, roomOf[x]);
+        }
+        for (int x : chain) rawMove(x, slotOf[x] == s1 ? s2 : s1, roomOf[x]);
+        return d;
+    }
+
+    // Krok SA po planach bez konfliktów: ruch przechodzi, gdy nie pogarsza kosztu twardego
+    // (od zera - nie tworzy konfliktu), z prawdopodobieństwem wg zmiany kosztu miękkiego.
+    bool stepSoft(double T) {
+        int v = rng.below(vars.size());
+        int s0 = slotOf[v];
+        int ns = pickSlot(v);
+        if (ns == s0) return false;
+        if (blockLen[v] > 1) {
+            int h = blockFirst[v];
+            if (!planBlock(h, ns) || deltaBlock(h) > 0 || !accept(softDeltaBlock(h), T)) return false;
+            applyBlock(h);
+        } else if (double z = rng.uniform(); z < moves.swap) {
+            const vector<int>& there = slotVars[ns];
+            if (there.empty()) return false;
+            int u = there[rng.below(there.size())];
+            if (blockLen[u] > 1 || vars[u].lessonIdx == vars[v].lessonIdx || deltaSwap(v, u) > 0 || !accept(softDeltaSwap(v, u), T)) return false;
+            applySwap(v, u);
+        } else if (z < moves.swap + moves.kempe) {
+            if (!buildChain(v, ns) || deltaChain(s0, ns) > 0 || !accept(softDeltaChain(s0, ns), T)) return false;
+            applyChain(s0, ns);
+        } else {
+            int nr = pickFreeRoom(v, ns);
+            if (deltaMove(v, ns, nr) > 0 || !accept(softMoveDelta(v, ns), T)) return false;
+            applyMove(v, ns, nr);
+        }
+        if (curCost == 0 && softCost < bestSoft) {
+            bestSoft = softCost;
+            saveBest();
+        }
+        return true;
+    }
+
+    // Druga faza po znalezieniu planu bez konfliktów: SA na koszcie miękkim (wagi soft), startując
+    // od najlepszego planu. Zwraca liczbę iteracji; 0, gdy plan ma konflikty lub wagi są zerowe.
+    int saSoft(int maxIters = 400000, double T0 = 1.0, double alpha = 0.99999) {
+        if (bestCost != 0 || !enableSoft()) return 0;
+        restoreBest();
+        bestSoft = softCost;
+        saveBest();
+
+        const double alpha64 = pow(alpha, 64);
+        double T = T0;
+        int it = 0;
+        for (; it < maxIters && bestSoft > 0; ++it) {
+            if ((it & 1023) == 0 && cancelled()) break;
+            stepSoft(T);
+            if ((it & 63) == 63) T *= alpha64;
+        }
+        restoreBest();
+        return it;
+    }
+};
+
+#endif
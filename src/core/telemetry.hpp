@@ -0,0 +1,124 @@
+#ifndef TELEMETRY_HPP_
+#define TELEMETRY_HPP_
+
+#include <bits/stdc++.h>
+using namespace std;
+
+/// ====== TELEMETRIA SA ======
+//
+// Włączana makrem SCHEDULER_TELEMETRY (opcja CMake o tej samej nazwie). Bez niego TELEMETRY(...)
+// znika, a TELEMETRY_TIME(faza, wyrażenie) to samo wyrażenie - solver nie ma wtedy ani pola
+// telemetry, ani żadnej instrukcji więcej w pętli.
+//
+// Zbiera: liczby ruchów proponowanych/przyjętych wg rodzaju ruchu, czas faz kroku (losowanie
+// kandydatów - następca dawnych orderValues()/orderRooms() - liczenie delty, wykonanie ruchu)
+// oraz okna po `window` iteracji sa(): temperaturę, odsetek przyjętych ruchów, średni
+// i najmniejszy koszt bieżący i najlepszy koszt. Okna są w pamięci (solver zostaje kopiowalny),
+// writeTrace() zapisuje je jako CSV.
+
+#ifdef SCHEDULER_TELEMETRY
+#define TELEMETRY(...) __VA_ARGS__
+#define TELEMETRY_TIME(phase, ...) (telemetry.timed(Telemetry::phase, [&] { return __VA_ARGS__; }))
+#else
+#define TELEMETRY(...)
+#define TELEMETRY_TIME(phase, ...) (__VA_ARGS__)
+#endif
+
+struct Telemetry {
+    enum Move { Room, Slot, Matched, Swap, Kempe, Block, MOVES };
+    enum Phase { Pick, Delta, Apply, PHASES };
+    static constexpr const char* MOVE_NAME[MOVES] = {"room", "slot", "matched", "swap", "kempe", "block"};
+    static constexpr const char* PHASE_NAME[PHASES] = {"pick", "delta", "apply"};
+
+    struct Window {
+        int it;
+        double T;
+        double acceptRatio;
+        double meanCost;
+        int minCost, bestCost;
+    };
+
+    long long proposed[MOVES] = {}, accepted[MOVES] = {};
+    long long nanos[PHASES] = {}, calls[PHASES] = {};
+    int window = 1000;
+    vector<Window> windows;
+
+    // Stan bieżącego okna.
+    int winStart = 0, winSteps = 0, winAccepted = 0, winMin = INT_MAX;
+    long long winCostSum = 0;
+    double winT = 0;
+
+    template <class F> auto timed(Phase p, F&& f) {
+        auto t0 = chrono::steady_clock::now();
+        auto stop = [&] {
+            nanos[p] += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+            calls[p]++;
+        };
+        if constexpr (is_void_v<invoke_result_t<F>>) {
+            f();
+            stop();
+        } else {
+            auto r = f();
+            stop();
+            return r;
+        }
+    }
+
+    void propose(Move m) { proposed[m]++; }
+    void accept(Move m) { accepted[m]++; }
+
+    // Początek przebiegu sa(): porzuca niedomknięte okno poprzedniego.
+    void begin() { winSteps = 0; }
+
+    // Po każdej iteracji sa(); domyka okno co `window` iteracji.
+    void tick(int it, double T, bool acc, int cost, int best) {
+        if (winSteps == 0) {
+            winStart = it;
+            winT = T;
+            winAccepted = 0;
+            winCostSum = 0;
+            winMin = INT_MAX;
+        }
+        winSteps++;
+        winAccepted += acc;
+        winCostSum += cost;
+        winMin = min(winMin, cost);
+        if (winSteps >= window) {
+            windows.push_back({winStart, winT, (double)winAccepted / winSteps, (double)winCostSum / winSteps, winMin, best});
+            winSteps = 0;
+        }
+    }
+
+    bool writeTrace(const string& path, ostream& os = cerr) const {
+        ofstream out(path);
+        if (!out) {
+            os << "[ERR] nie można zapisać " << path << "\n";
+            return false;
+        }
+        out << "it,T,accept_ratio,mean_cost,min_cost,best_cost\n";
+        for (const Window& w : windows) {
+            out << w.it << ',' << w.T << ',' << w.acceptRatio << ',' << w.meanCost << ',' << w.minCost << ','
+                << w.bestCost << '\n';
+        }
+        return true;
+    }
+
+    void report(ostream& os) const {
+        os << "ruch        proponowane   przyjete   odsetek\n";
+        for (int m = 0; m < MOVES; ++m) {
+            if (proposed[m] == 0) continue;
+            os << left << setw(10) << MOVE_NAME[m] << right << setw(13) << proposed[m] << setw(11) << accepted[m]
+               << setw(10) << fixed << setprecision(4) << (double)accepted[m] / proposed[m] << '\n';
+        }
+        os << "faza        wywolania   czas[ms]   ns/wywolanie\n";
+        for (int p = 0; p < PHASES; ++p) {
+            if (calls[p] == 0) continue;
+            os << left << setw(10) << PHASE_NAME[p] << right << setw(11) << calls[p] << setw(11) << fixed
+               << setprecision(1) << nanos[p] / 1e6 << setw(15) << (double)nanos[p] / calls[p] << '\n';
+        }
+        os.unsetf(ios::floatfield);
+        os << setprecision(6);
+    }
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef TEMPERING_HPP_
+#define TEMPERING_HPP_
+
+#include "solver.hpp"
+#include <barrier>
+
+struct TemperingParams {
+    int replicas = 8;
+    int threads = max(1u, thread::hardware_concurrency());
+    double Tmin = 0.05, Tmax = 2.5;  // drabina temperatur geometryczna od Tmin do Tmax
+    int sweep = 2000;                // iteracje każdej repliki między próbami wymiany
+    long long maxIters = 1200000;    // łączny budżet iteracji na replikę
+    uint32_t seed = 12345;
+};
+
+// Parallel tempering (replica exchange): R kopii stanu solvera działa w stałych temperaturach
+// na wątkach roboczych, a po każdej rundzie sąsiednie temperatury próbują wymienić się replikami.
+// Trajektoria każdej repliki zależy tylko od jej własnego rng i przydzielonych temperatur,
+// a wymiany losuje jeden wątek generatorem mistrza - wynik jest więc powtarzalny dla danego seeda.
+// Najlepszy plan ze wszystkich replik trafia do solver.bestAssign/bestAssignRooms. Przerwanie
+// i termin solvera (cancelled()) są sprawdzane w każdej rundzie wymiany.
+// Zwraca liczbę wykonanych iteracji na replikę.
+inline long long parallelTempering(Solver& solver, const TemperingParams& p) {
+    const int R = max(1, p.replicas);
+    const int W = max(1, min(p.threads, R));
+
+    vector<double> temp(R);
+    for (int k = 0; k < R; ++k) {
+        temp[k] = R == 1 ? p.Tmin : p.Tmin * pow(p.Tmax / p.Tmin, (double)k / (R - 1));
+    }
+
+    vector<Solver> rep;
+    rep.reserve(R);
+    for (int i = 0; i < R; ++i) {
+        rep.push_back(solver);
+        seed_seq sq{p.seed, (uint32_t)i};
+        rep[i].rng.seed(sq);
+        rep[i].saveBest();
+    }
+    // at[k] - replika pracująca obecnie w temperaturze temp[k]
+    vector<int> at(R);
+    iota(at.begin(), at.end(), 0);
+
+    SolverRng master(p.seed);
+    long long done = 0;
+    int round = 0;
+    bool finished = false;
+
+    auto exchange = [&]() noexcept {
+        done += p.sweep;
+        for (int k = round & 1; k + 1 < R; k += 2) {
+            const Solver& a = rep[at[k]];
+            const Solver& b = rep[at[k + 1]];
+            double x = (1.0 / temp[k] - 1.0 / temp[k + 1]) * (a.curCost - b.curCost);
+            if (x >= 0 || master.uniform() < exp(x)) {
+                swap(at[k], at[k + 1]);
+            }
+        }
+        round++;
+        for (const Solver& r : rep) finished |= r.bestCost == 0;
+        finished |= done >= p.maxIters || solver.cancelled();
+    };
+    barrier sync(W, exchange);
+
+    auto worker = [&](int w) {
+        while (!finished) {
+            for (int k = w; k < R; k += W) {
+                Solver& r = rep[at[k]];
+                for (int it = 0; it < p.sweep && r.bestCost > 0; ++it) r.step(temp[k]);
+            }
+            sync.arrive_and_wait();
+        }
+    };
+    vector<thread> pool;
+    for (int w = 1; w < W; ++w) pool.emplace_back(worker, w);
+    worker(0);
+    for (auto& t : pool) t.join();
+
+    int best = 0;
+    for (int i = 1; i < R; ++i) {
+        if (rep[i].bestCost < rep[best].bestCost) best = i;
+    }
+    solver.bestAssign = rep[best].bestAssign;
+    solver.bestAssignRooms = rep[best].bestAssignRooms;
+    solver.restoreBest();
+    solver.bestCost = solver.curCost;
+    return done;
+}
+
+#endif
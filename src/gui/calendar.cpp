@@ -3,6 +3,7 @@
 #include <QApplication>
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
+#include <array>
 #include <assert.h>
 
 Calendar::Calendar(uint8_t hour_start, uint8_t hour_end, QObject *parent)
@@ -144,6 +145,19 @@ void Calendar::add_event(Event::EventData event_data) {
     this->addItem(new_event);
 }
 
+void Calendar::add_events(const std::vector<Event::EventData> &events) {
+    std::array<bool, kWeekDaysSize> touched_days{};
+    for (const Event::EventData &data : events) {
+        this->add_event(data);
+        touched_days[data.week_day] = true;
+    }
+    for (uint8_t week_day = 0; week_day < kWeekDaysSize; ++week_day) {
+        if (touched_days[week_day]) {
+            this->refresh_day_graphicly(week_day);
+        }
+    }
+}
+
 void Calendar::refresh_day_graphicly(uint8_t week_day) {
     std::vector<std::vector<Event *>> event_groups = this->select_event_groups(week_day);
     // Adjust values for new size
@@ -37,6 +37,12 @@ public:
     //
     // @param event_data information about new event.
     void add_event(Event::EventData event_data);
+    // @brief Create many events and lay out every day they touch.
+    //
+    // Each affected day is refreshed once, instead of once per event as interactive adding does.
+    //
+    // @param events information about new events.
+    void add_events(const std::vector<Event::EventData> &events);
     // @brief Checks if QTime is present in the calendar.
     bool time_in_calendar(QTime time) const {
         return (time.hour() >= hour_start_) &&
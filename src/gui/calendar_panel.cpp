@@ -1,6 +1,7 @@
 
 #include "calendar_panel.hpp"
 #include <QComboBox>
+#include <QFileDialog>
 #include <QGraphicsView>
 #include <QHBoxLayout>
 #include <QLineEdit>
@@ -9,6 +10,7 @@
 
 CalendarPanel::CalendarPanel(QWidget *parent) : QWidget(parent) {
     qRegisterMetaType<Calendar *>("Calendar*");
+    qRegisterMetaType<SolverResult>("SolverResult");
     calendar_selector_->setInsertPolicy(QComboBox::InsertAtCurrent);
     calendar_selector_->setEditable(true);
     // Connecting change of scene
@@ -22,11 +24,28 @@ CalendarPanel::CalendarPanel(QWidget *parent) : QWidget(parent) {
     auto *delete_button = new QPushButton(kDeleteButtonText, controls_widget);
     connect(delete_button, &QPushButton::clicked, this, &CalendarPanel::remove_calendar_data);
     delete_button->setStyleSheet("background-color: red; color: white;");
+    // Solver running on its own thread
+    solver_worker_->moveToThread(&solver_thread_);
+    connect(&solver_thread_, &QThread::finished, solver_worker_, &QObject::deleteLater);
+    connect(this, &CalendarPanel::solve_requested, solver_worker_, &SolverWorker::solve);
+    connect(solver_worker_, &SolverWorker::started, cancel_button_, [this] { cancel_button_->setEnabled(true); });
+    connect(solver_worker_, &SolverWorker::progress, this, &CalendarPanel::show_solver_progress);
+    connect(solver_worker_, &SolverWorker::finished, this, &CalendarPanel::show_solver_result);
+    connect(solver_worker_, &SolverWorker::failed, this, &CalendarPanel::show_solver_error);
+    solver_thread_.start();
+    connect(solve_button_, &QPushButton::clicked, this, &CalendarPanel::start_solver);
+    // Direct call, the worker thread is busy inside solve().
+    connect(cancel_button_, &QPushButton::clicked, this, [this] { solver_worker_->cancel(); });
+    cancel_button_->setEnabled(false);
+    solver_status_->setWordWrap(true);
     // Layout of controls
     auto *controls_layout = new QVBoxLayout;
     controls_layout->addWidget(calendar_selector_);
     controls_layout->addWidget(create_button);
     controls_layout->addWidget(delete_button);
+    controls_layout->addWidget(solve_button_);
+    controls_layout->addWidget(cancel_button_);
+    controls_layout->addWidget(solver_status_);
     controls_layout->addStretch();
     // Set layout
     controls_widget->setLayout(controls_layout);
@@ -51,3 +70,38 @@ void CalendarPanel::remove_calendar_data() {
     calendar_selector_->removeItem(calendar_selector_->currentIndex());
     scene_to_remove->deleteLater();
 }
+
+CalendarPanel::~CalendarPanel() {
+    solver_worker_->cancel();
+    solver_thread_.quit();
+    solver_thread_.wait();
+}
+
+void CalendarPanel::start_solver() {
+    QString instance_path = QFileDialog::getOpenFileName(this, kOpenInstanceTitle, QString(), kInstanceFilter);
+    solve_button_->setEnabled(false);
+    solver_status_->setText("Starting...");
+    emit solve_requested(instance_path);
+}
+
+void CalendarPanel::show_solver_progress(int iteration, int current_cost, int best_cost) {
+    solver_status_->setText(QString("Iteration %1\nCost %2, best %3").arg(iteration).arg(current_cost).arg(best_cost));
+}
+
+void CalendarPanel::show_solver_result(const SolverResult &result) {
+    for (size_t i = 0; i < result.events.size(); ++i) {
+        Calendar *calendar = new Calendar(result.hour_start, result.hour_end, this);
+        calendar->add_events(result.events[i]);
+        add_calendar_data(calendar, result.titles[i]); // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+    }
+    QString status = result.cost == 0 ? QString("Solved") : QString("%1 conflicts left").arg(result.cost);
+    solver_status_->setText(result.cancelled ? status + " (cancelled)" : status);
+    solve_button_->setEnabled(true);
+    cancel_button_->setEnabled(false);
+}
+
+void CalendarPanel::show_solver_error(const QString &message) {
+    solver_status_->setText(message);
+    solve_button_->setEnabled(true);
+    cancel_button_->setEnabled(false);
+}
@@ -8,9 +8,13 @@
 #define MAIN_WIDGET_HPP_
 
 #include "calendar.hpp"
+#include "solver_worker.hpp"
 #include <QComboBox>
 #include <QGraphicsView>
+#include <QLabel>
 #include <QLineEdit>
+#include <QPushButton>
+#include <QThread>
 #include <QWidget>
 
 // Allow Calendar* to be used as a QVariant
@@ -20,10 +24,16 @@ Q_DECLARE_METATYPE(Calendar *)
 // @brief Widget for managing calendars.
 class CalendarPanel : public QWidget {
     Q_OBJECT
+signals:
+    // @brief Queued to the solver thread, see @ref SolverWorker::solve.
+    void solve_requested(QString instance_path);
+
 public:
     // @brief Default QWidget creator.
     // @param parent Owner of the widget.
     explicit CalendarPanel(QWidget *parent = nullptr);
+    // @brief Stops the running solver and waits for its thread.
+    ~CalendarPanel() override;
     // @brief Creates default calendar with predefined time.
     Calendar *create_default_calendar() { return new Calendar(8, 18, this); };
     // @brief Use for adding a new calendar to the combobox allowing for sellection.
@@ -32,16 +42,37 @@ public:
     void set_calendar_data() { calendar_view_->setScene(calendar_selector_->currentData().value<Calendar *>()); };
     // @brief Remove calendar from the combobox and memory.
     void remove_calendar_data();
+    // @brief Ask for an instance file and solve it on the solver thread.
+    //
+    // Cancelling the file dialog solves the built-in instance.
+    void start_solver();
+    // @brief Show progress reported by the solver.
+    void show_solver_progress(int iteration, int current_cost, int best_cost);
+    // @brief Add one calendar per group of the solved timetable.
+    void show_solver_result(const SolverResult &result);
+    // @brief Show why the solver could not run.
+    void show_solver_error(const QString &message);
 
 private:
     // Constants for visiuals.
     inline static const QString kDefaultCalendarName = "New Calendar";
     inline static const QString kCreateButtonText = "Create";
     inline static const QString kDeleteButtonText = "Delete";
+    inline static const QString kSolveButtonText = "Solve";
+    inline static const QString kCancelButtonText = "Cancel";
+    inline static const QString kOpenInstanceTitle = "Open instance (cancel for the built-in one)";
+    inline static const QString kInstanceFilter = "Instances (*.txt *.bin);;All files (*)";
     // View of the calendars.
     QGraphicsView *calendar_view_ = new QGraphicsView(this);
     // Selector for the calendars.
     QComboBox *calendar_selector_ = new QComboBox;
+    // Solver controls, only one run at a time.
+    QPushButton *solve_button_ = new QPushButton(kSolveButtonText);
+    QPushButton *cancel_button_ = new QPushButton(kCancelButtonText);
+    QLabel *solver_status_ = new QLabel;
+    // Thread owning the solver worker, the worker deletes itself when the thread finishes.
+    QThread solver_thread_;
+    SolverWorker *solver_worker_ = new SolverWorker;
 };
 
 #endif
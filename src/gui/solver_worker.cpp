@@ -0,0 +1,83 @@
+// Solver headers go before any Qt header: Qt defines `emit` and `slots` as keyword macros, and those names
+// appear in the standard library (<syncstream>) and in the solver (Instance::slots).
+#include "../core/loader.hpp"
+#include "../core/portfolio.hpp"
+#include "const.hpp"
+#include "solver_worker.hpp"
+#include <QThread>
+// This file declares no slots, so the name is released for Instance::slots.
+#undef slots
+
+SolverWorker::SolverWorker(QObject *parent) : QObject(parent), shared_(std::make_unique<SharedProgress>()) {}
+
+SolverWorker::~SolverWorker() = default;
+
+void SolverWorker::cancel() { shared_->stop.store(true, std::memory_order_relaxed); }
+
+void SolverWorker::report_progress(int iteration, int current_cost, int best_cost) {
+    qint64 now = run_timer_.elapsed();
+    qint64 last = last_progress_ms_.load(std::memory_order_relaxed);
+    if (now - last < kProgressIntervalMs ||
+        !last_progress_ms_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+        return;
+    }
+    emit progress(iteration, current_cost, std::min(best_cost, shared_->bestCost.load(std::memory_order_relaxed)));
+}
+
+void SolverWorker::solve(QString instance_path) {
+    // Reset state of the previous run.
+    shared_->stop.store(false);
+    shared_->bestCost.store(INT_MAX);
+    last_progress_ms_.store(-kProgressIntervalMs);
+    run_timer_.start();
+    emit started();
+    // Load instance
+    Instance instance;
+    std::ostringstream errors;
+    if (instance_path.isEmpty()) {
+        instance = generateNaStyk();
+    } else if (!loadInstance(instance_path.toStdString(), instance, errors)) {
+        emit failed(QString::fromStdString(errors.str()).trimmed());
+        return;
+    }
+    // Solve on all cores but one, so the event loop keeps its own.
+    Solver solver(instance.slots, instance.lessons, instance.rooms, instance.domains,
+                  static_cast<int>(instance.groupName.size()), static_cast<int>(instance.teacherName.size()));
+    solver.shared = shared_.get();
+    solver.onProgress = [this](int iteration, int current_cost, int best_cost) {
+        report_progress(iteration, current_cost, best_cost);
+    };
+    PortfolioParams params;
+    params.workers = std::max(1, QThread::idealThreadCount() - 1);
+    portfolioSolve(solver, params);
+    solver.canonicalize();
+    // Convert plan to events, one calendar per group.
+    SolverResult result;
+    result.cost = solver.bestCost;
+    result.cancelled = shared_->stop.load() && solver.bestCost > 0;
+    int periods = 0;
+    for (const Slot &slot : instance.slots) {
+        periods = std::max(periods, slot.period + 1);
+    }
+    result.hour_start = kFirstHour;
+    result.hour_end = static_cast<uint8_t>(std::min(24, kFirstHour + periods));
+    for (const std::string &name : instance.groupName) {
+        result.titles.append(QString::fromStdString(name));
+    }
+    result.events.resize(instance.groupName.size());
+    for (int v = 0; v < static_cast<int>(solver.vars.size()); ++v) {
+        const Lesson &lesson = solver.lessons[solver.vars[v].lessonIdx];
+        const Slot &slot = instance.slots[solver.bestAssign[v]];
+        // Skip what does not fit into the week grid.
+        if (slot.day >= kWeekDaysSize || kFirstHour + slot.period >= result.hour_end) {
+            continue;
+        }
+        QString title = QString::fromStdString(instance.subjectName[lesson.subject] + " (" +
+                                               instance.teacherName[lesson.teacher] + ", " +
+                                               solver.rooms[solver.bestAssignRooms[v]].roomName + ")");
+        QTime start(kFirstHour + slot.period, 0);
+        result.events[lesson.group].push_back(
+            {title, static_cast<uint8_t>(slot.day), start, start.addSecs(60 * 60)});
+    }
+    emit finished(result);
+}
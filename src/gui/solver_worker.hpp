@@ -0,0 +1,89 @@
+// @file solver_worker.hpp
+// @brief Runs the timetable solver from src/core on a background thread.
+//
+// Threading:
+// - SolverWorker is moved to its own QThread; solve() blocks that thread, never the GUI one.
+// - The solver itself uses idealThreadCount() - 1 threads, leaving one core for the event loop.
+// - Results and progress reach the GUI only through queued signals.
+
+#ifndef SOLVER_WORKER_HPP_
+#define SOLVER_WORKER_HPP_
+
+#include "event.hpp"
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct SharedProgress;
+
+// @struct SolverResult
+// @brief Best plan of a solver run, already split into one calendar per group.
+//
+// Value type: copyable, passed through queued signals.
+//
+// Fields:
+// - titles: Calendar title of every group.
+// - events: Events of every group, in the same order as titles.
+// - hour_start, hour_end: Hours the calendars must show.
+// - cost: Number of violated hard constraints, 0 means a valid timetable.
+// - cancelled: Run was stopped by @ref SolverWorker::cancel() before finding a valid timetable.
+struct SolverResult {
+    QStringList titles;
+    std::vector<std::vector<Event::EventData>> events;
+    uint8_t hour_start = 8;
+    uint8_t hour_end = 18;
+    int cost = 0;
+    bool cancelled = false;
+};
+
+Q_DECLARE_METATYPE(SolverResult)
+
+// @class SolverWorker
+// @brief QObject wrapper which loads an instance, solves it and converts the plan to events.
+class SolverWorker : public QObject {
+    Q_OBJECT
+signals:
+    // @brief Run has started, from now on @ref cancel() affects it.
+    void started();
+    // @brief Progress of the run, emitted at most once every kProgressIntervalMs.
+    void progress(int iteration, int current_cost, int best_cost);
+    // @brief Run has ended, also after cancel, with the best plan found.
+    void finished(SolverResult result);
+    // @brief Run could not start, e.g. the instance file is invalid.
+    void failed(QString message);
+
+public:
+    // @brief Default QObject creator.
+    // @param parent Owner of the worker, must be nullptr when the worker is moved to a thread.
+    explicit SolverWorker(QObject *parent = nullptr);
+    ~SolverWorker() override;
+    // @brief Ask the current run to stop.
+    //
+    // Safe to call from any thread. The solver notices it within 1024 iterations.
+    void cancel();
+
+public slots:
+    // @brief Load the instance and solve it.
+    // @param instance_path Text or binary instance file, empty for the built-in instance.
+    void solve(QString instance_path);
+
+private:
+    // Around 60 progress signals per second, matching the display refresh.
+    inline static constexpr qint64 kProgressIntervalMs = 16;
+    // Hour of the first period of the day.
+    inline static constexpr uint8_t kFirstHour = 8;
+    // Stop flag and best cost shared with all solver threads.
+    std::unique_ptr<SharedProgress> shared_;
+    // Time of the last progress signal, in ms since the run started.
+    std::atomic<qint64> last_progress_ms_{0};
+    QElapsedTimer run_timer_;
+    // @brief Emit progress unless another one was emitted less than kProgressIntervalMs ago.
+    //
+    // Called from solver threads, only one of them wins each interval.
+    void report_progress(int iteration, int current_cost, int best_cost);
+};
+
+#endif